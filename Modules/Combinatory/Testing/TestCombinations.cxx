@@ -20,6 +20,13 @@
 #include <gtest/gtest.h>
 #include <combinations.hxx>
 
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
 using namespace huc::combinatory;
 
 #ifndef DOXYGEN_SKIP
@@ -86,3 +93,179 @@ TEST(TestCombinations, Combinations)
     //@TODO check sequence by sequence? (non ordered)
   }
 }
+
+// Test compact combinations, masks and flat buffer
+TEST(TestCombinations, FlatCombinations)
+{
+  // Empty and inversed ranges - no combinations
+  {
+    const Container kUnicCollection = Container(1, 10);
+    EXPECT_TRUE(CombinationMasks(kUnicCollection.begin(), kUnicCollection.begin()).empty());
+    EXPECT_TRUE(CombinationMasks(kUnicCollection.end(), kUnicCollection.begin()).empty());
+
+    FlatCombinations<Const_IT> combinations(kUnicCollection.end(), kUnicCollection.begin());
+    EXPECT_EQ(static_cast<size_t>(0), combinations.Size());
+    EXPECT_TRUE(combinations.begin() == combinations.end());
+  }
+
+  // Same subsets, in the same order, as the ones returned by Combinations
+  {
+    const Container kSequence = {5, 8, 1, 4, 7, 2};
+    const List kExpected = Combinations<Container, Const_IT>(kSequence.begin(), kSequence.end());
+    const auto kMasks = CombinationMasks(kSequence.begin(), kSequence.end());
+    const FlatCombinations<Const_IT> kCombinations(kSequence.begin(), kSequence.end());
+    ASSERT_EQ(kExpected.size(), kMasks.size());
+    ASSERT_EQ(kExpected.size(), kCombinations.Size());
+    EXPECT_EQ(kCombinations.Offsets().back(), kCombinations.Elements().size());
+
+    auto flat = kCombinations.begin();
+    auto mask = kMasks.begin();
+    for (auto it = kExpected.begin(); it != kExpected.end(); ++it, ++flat, ++mask)
+    {
+      EXPECT_EQ(*it, Container(flat->begin(), flat->end()));
+
+      const SubsetView<Const_IT> kSubset(kSequence.begin(), *mask);
+      Container subset(kSubset.begin(), kSubset.end());
+      Container expected(*it);
+      std::sort(subset.begin(), subset.end());
+      std::sort(expected.begin(), expected.end());
+      EXPECT_EQ(expected, subset);
+    }
+    EXPECT_TRUE(flat == kCombinations.end());
+    EXPECT_EQ(static_cast<size_t>(0), kCombinations[kCombinations.Size()].size());
+  }
+}
+
+// Test binomial coefficients
+TEST(TestCombinations, Binomial)
+{
+  EXPECT_EQ(1u, Binomial(0, 0));
+  EXPECT_EQ(0u, Binomial(3, 4));
+  EXPECT_EQ(252u, Binomial(10, 5));
+  EXPECT_EQ(1832624140942590534u, Binomial(64, 32));
+  EXPECT_EQ(0u, Binomial(100, 50));
+  EXPECT_EQ(4950u, Binomial(100, 98));
+}
+
+// Test subsets enumerated in Gray code order
+TEST(TestCombinations, GraySubsets)
+{
+  // All the subsets, each one differing from the previous one by a single element
+  for (unsigned int n = 0; n <= 10; ++n)
+  {
+    std::set<std::uint64_t> visited;
+    std::uint64_t previous = 0;
+    for (GraySubsets subsets(n); subsets.IsValid(); subsets.Next())
+    {
+      if (!visited.empty())
+      {
+        EXPECT_EQ(previous ^ subsets.Mask(), 1ull << subsets.Changed());
+      }
+      EXPECT_EQ(subsets.Rank(), GrayCodeRank(subsets.Mask()));
+      EXPECT_EQ(subsets.Mask(), GrayCodeUnrank(subsets.Rank()));
+      EXPECT_EQ(0u, subsets.Mask() >> n);
+
+      visited.insert(subsets.Mask());
+      previous = subsets.Mask();
+    }
+    EXPECT_EQ(static_cast<std::size_t>(1) << n, visited.size());
+  }
+
+  // Starting from a given rank, up to the last subset of 64 elements
+  {
+    GraySubsets subsets(8, 200);
+    int count = 0;
+    for (; subsets.IsValid(); subsets.Next())
+      ++count;
+    EXPECT_EQ(56, count);
+    EXPECT_FALSE(GraySubsets(8, 256).IsValid());
+
+    GraySubsets lastSubsets(64, ~0ull);
+    EXPECT_TRUE(lastSubsets.IsValid());
+    EXPECT_FALSE(lastSubsets.Next());
+  }
+
+  // Same subsets as Combinations using a view on the sequence
+  {
+    const Container kSmallArray(SmallIntArray, SmallIntArray + sizeof(SmallIntArray) / sizeof(Value));
+    const List kCombinations = Combinations<Container, Const_IT>(kSmallArray.begin(), kSmallArray.end());
+    std::set<Container> expected;
+    for (auto it = kCombinations.begin(); it != kCombinations.end(); ++it)
+    {
+      Container sorted = *it;
+      std::sort(sorted.begin(), sorted.end());
+      expected.insert(sorted);
+    }
+
+    std::set<Container> visited;
+    for (GraySubsets subsets(3); subsets.Next(); )
+    {
+      const SubsetView<Const_IT> kView(kSmallArray.begin(), subsets.Mask());
+      Container subset(kView.begin(), kView.end());
+      EXPECT_EQ(subset.size(), kView.size());
+      std::sort(subset.begin(), subset.end());
+      visited.insert(subset);
+    }
+    EXPECT_EQ(expected, visited);
+  }
+}
+
+// Test k-combinations enumerated using Gosper's hack and multiple words
+TEST(TestCombinations, KCombinations)
+{
+  // C(n, k) combinations of k elements in increasing order
+  for (unsigned int n = 0; n <= 12; ++n)
+    for (unsigned int k = 0; k <= n + 1; ++k)
+    {
+      unsigned long long count = 0;
+      std::uint64_t previous = 0;
+      for (KCombinations combinations(n, k); combinations.IsValid(); combinations.Next(), ++count)
+      {
+        const auto kMask = combinations.Mask();
+        EXPECT_TRUE(count == 0 || kMask > previous);
+        EXPECT_EQ(k, SubsetView<Const_IT>(Const_IT(), kMask).size());
+        EXPECT_EQ(count, CombinationRank(kMask));
+        EXPECT_EQ(kMask, CombinationUnrank(count, k));
+        previous = kMask;
+      }
+      EXPECT_EQ(Binomial(n, k), count);
+    }
+
+  // Starting from a given rank, 64 elements
+  {
+    int count = 0;
+    for (KCombinations combinations(64, 2, Binomial(64, 2) - 3); combinations.IsValid(); combinations.Next())
+      ++count;
+    EXPECT_EQ(3, count);
+    EXPECT_FALSE(KCombinations(64, 2, Binomial(64, 2)).IsValid());
+    EXPECT_EQ(0xC000000000000000ull, CombinationUnrank(Binomial(64, 2) - 1, 2));
+  }
+
+  // More than 64 elements - same combinations as Gosper's hack on the lowest ones, all distinct
+  {
+    const unsigned int kN = 70;
+    const unsigned int kK = 3;
+    std::set<std::vector<std::uint64_t>> visited;
+    KCombinations lowest(64, kK);
+    for (KCombinations combinations(kN, kK); combinations.IsValid(); combinations.Next())
+    {
+      unsigned int bits = 0;
+      for (unsigned int i = 0; i < kN; ++i)
+        bits += combinations.Test(i) ? 1 : 0;
+      EXPECT_EQ(kK, bits);
+
+      if (lowest.IsValid())
+      {
+        EXPECT_EQ(lowest.Mask(), combinations.Words()[0]);
+        EXPECT_EQ(0u, combinations.Words()[1]);
+        lowest.Next();
+      }
+      visited.insert(combinations.Words());
+    }
+    EXPECT_EQ(Binomial(kN, kK), visited.size());
+
+    // Starting point within the second word
+    KCombinations combinations(100, 2, Binomial(99, 2));
+    EXPECT_TRUE(combinations.Test(0) && combinations.Test(99) && !combinations.Test(1));
+  }
+}
@@ -21,7 +21,11 @@
 #include <intersection.hxx>
 
 // STD includes
+#include <algorithm>
 #include <list>
+#include <random>
+#include <string>
+#include <vector>
 
 using namespace huc::combinatory;
 
@@ -41,6 +45,15 @@ namespace {
   typedef std::vector<int> Container;
   typedef Container::value_type Value;
   typedef Container::const_iterator Const_IT;
+
+  // Key only providing operator< (no std::hash, operator== nor default constructor)
+  struct OrderedKey
+  {
+    explicit OrderedKey(int key) : key(key) {}
+    bool operator<(const OrderedKey& other) const { return this->key < other.key; }
+
+    int key;
+  };
 }
 #endif /* DOXYGEN_SKIP */
 
@@ -121,3 +134,216 @@ TEST(TestIntersection, Intersections)
     EXPECT_EQ('g', intersection[3]);
   }
 }
+
+// Test intersection strategies against a reference intersection
+TEST(TestIntersection, Strategies)
+{
+  std::mt19937 generator(42);
+  const std::size_t kSizes[] = {0, 1, 7, 100, 5000};
+  for (auto firstSize : kSizes)
+  {
+    for (auto secondSize : kSizes)
+    {
+      // Few distinct values for many dupplicates
+      std::uniform_int_distribution<int> distribution(-50, 50);
+      Container first(firstSize);
+      Container second(secondSize);
+      for (auto it = first.begin(); it != first.end(); ++it)
+        *it = distribution(generator);
+      for (auto it = second.begin(); it != second.end(); ++it)
+        *it = distribution(generator);
+
+      // Unsorted sequences - hash strategy selected
+      Container hash = IntersectionHash<Container, Const_IT>(first.begin(), first.end(),
+                                                             second.begin(), second.end());
+      Container intersection = Intersection<Container, Const_IT>(first.begin(), first.end(),
+                                                                 second.begin(), second.end());
+      EXPECT_EQ(hash, intersection);
+      Container prefiltered = Intersection<Container, Const_IT>(first.begin(), first.end(),
+                                                                second.begin(), second.end(), true);
+      EXPECT_EQ(hash, prefiltered);
+
+      std::sort(first.begin(), first.end());
+      std::sort(second.begin(), second.end());
+      Container expected;
+      std::set_intersection(first.begin(), first.end(), second.begin(), second.end(),
+                            std::back_inserter(expected));
+      std::sort(hash.begin(), hash.end());
+      EXPECT_EQ(expected, hash);
+
+      // Sorted sequences - sorted intersection whatever the strategy
+      EXPECT_EQ(expected, (IntersectionMerge<Container, Const_IT>(first.begin(), first.end(),
+                                                                  second.begin(), second.end())));
+      EXPECT_EQ(expected, (IntersectionGalloping<Container, Const_IT>(first.begin(), first.end(),
+                                                                      second.begin(), second.end())));
+      EXPECT_EQ(expected, (Intersection<Container, Const_IT>(first.begin(), first.end(),
+                                                             second.begin(), second.end())));
+    }
+  }
+
+  // Very different sizes on sorted sequences - galloping selected
+  {
+    Container large(100000);
+    for (std::size_t i = 0; i < large.size(); ++i)
+      large[i] = static_cast<int>(2 * i);
+    const Container kSmall = {-4, 0, 0, 7, 1000, 1001, 199998, 200000};
+    const Container kExpected = {0, 1000, 199998};
+    EXPECT_EQ(kExpected, (Intersection<Container, Const_IT>(kSmall.begin(), kSmall.end(),
+                                                            large.begin(), large.end())));
+    EXPECT_EQ(kExpected, (Intersection<Container, Const_IT>(large.begin(), large.end(),
+                                                            kSmall.begin(), kSmall.end())));
+  }
+
+  // Non random-access iterators
+  {
+    const std::list<int> kFirst = {1, 2, 2, 3, 5};
+    const std::list<int> kSecond = {2, 2, 2, 5, 8};
+    const Container kExpected = {2, 2, 5};
+    EXPECT_EQ(kExpected, (Intersection<Container, std::list<int>::const_iterator>
+      (kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end())));
+  }
+}
+
+// Test intersection of sorted posting lists (blocks of unique keys compared at once)
+TEST(TestIntersection, PostingLists)
+{
+  typedef std::vector<unsigned int> Keys;
+  std::mt19937 generator(7);
+  const unsigned int kGaps[] = {1, 2, 3, 10, 1000};
+  for (auto firstGap : kGaps)
+  {
+    for (auto secondGap : kGaps)
+    {
+      // Increasing keys from the upper half of the unsigned range with a few dupplicates
+      Keys first;
+      Keys second;
+      std::uniform_int_distribution<unsigned int> firstStep(0, 2 * firstGap);
+      std::uniform_int_distribution<unsigned int> secondStep(0, 2 * secondGap);
+      for (unsigned int i = 0, key = 0x7FFFFF00u; i < 3000; ++i, key += firstStep(generator))
+        first.push_back(key);
+      for (unsigned int i = 0, key = 0x7FFFFF00u; i < 2000; ++i, key += secondStep(generator))
+        second.push_back(key);
+
+      Keys expected;
+      std::set_intersection(first.begin(), first.end(), second.begin(), second.end(),
+                            std::back_inserter(expected));
+      EXPECT_EQ(expected, (IntersectionMerge<Keys, Keys::const_iterator>(first.begin(), first.end(),
+                                                                         second.begin(), second.end())));
+      EXPECT_EQ(expected, (IntersectionMerge<Keys, Keys::const_iterator>(second.begin(), second.end(),
+                                                                         first.begin(), first.end())));
+    }
+  }
+
+  // Dupplicates around the blocks boundaries - each match consumes one occurence
+  {
+    const Keys kFirst = {1, 2, 3, 4, 4, 5, 6, 7, 8, 9, 10, 11, 12, 12, 12, 13, 14, 15, 16};
+    const Keys kSecond = {0, 2, 4, 6, 8, 8, 8, 9, 10, 12, 12, 14, 16, 18, 20, 22};
+    const Keys kExpected = {2, 4, 6, 8, 9, 10, 12, 12, 14, 16};
+    EXPECT_EQ(kExpected, (IntersectionMerge<Keys, Keys::const_iterator>(kFirst.begin(), kFirst.end(),
+                                                                        kSecond.begin(), kSecond.end())));
+    EXPECT_EQ(kExpected, (Intersection<Keys, Keys::const_iterator>(kSecond.begin(), kSecond.end(),
+                                                                   kFirst.begin(), kFirst.end())));
+  }
+}
+
+// Test radix-partitioned parallel hash intersection
+TEST(TestIntersection, ParallelIntersectionHash)
+{
+  std::mt19937 generator(5);
+  const int kMaxKeys[] = {100, 20000, 1000000};
+  for (auto maxKey : kMaxKeys)
+  {
+    std::uniform_int_distribution<int> distribution(-maxKey, maxKey);
+    Container first(60000);
+    Container second(45000);
+    for (auto it = first.begin(); it != first.end(); ++it)
+      *it = distribution(generator);
+    for (auto it = second.begin(); it != second.end(); ++it)
+      *it = distribution(generator);
+
+    Container expected = IntersectionHash<Container, Const_IT>(first.begin(), first.end(),
+                                                               second.begin(), second.end());
+    std::sort(expected.begin(), expected.end());
+    for (unsigned int threads = 1; threads <= 4; ++threads)
+    {
+      // Same elements as the sequential version, grouped by partition
+      Container intersection = ParallelIntersectionHash<Container, Const_IT>(first.begin(), first.end(),
+                                                                             second.begin(), second.end(),
+                                                                             threads);
+      std::sort(intersection.begin(), intersection.end());
+      EXPECT_EQ(expected, intersection);
+    }
+  }
+
+  // Small sequences - sequential version used
+  {
+    const Container kFirst = {4, 1, 4, 7};
+    const Container kSecond = {4, 9, 4, 4, 1};
+    const Container kExpected = {4, 4, 1};
+    EXPECT_EQ(kExpected, (ParallelIntersectionHash<Container, Const_IT>(kFirst.begin(), kFirst.end(),
+                                                                        kSecond.begin(), kSecond.end(), 4)));
+  }
+}
+
+// Test hash intersection prefiltered using a Bloom Filter
+TEST(TestIntersection, Prefilter)
+{
+  // Highly selective intersection - same result as without prefilter
+  std::mt19937 generator(9);
+  Container first(3000);
+  Container second(50000);
+  for (auto it = first.begin(); it != first.end(); ++it)
+    *it = static_cast<int>(generator() % 1000000);
+  for (auto it = second.begin(); it != second.end(); ++it)
+    *it = static_cast<int>(generator() % 1000000);
+
+  const Container kExpected = IntersectionHash<Container, Const_IT>(first.begin(), first.end(),
+                                                                    second.begin(), second.end());
+  EXPECT_EQ(kExpected, (IntersectionHash<Container, Const_IT>(first.begin(), first.end(),
+                                                              second.begin(), second.end(), true)));
+  EXPECT_EQ(kExpected, (IntersectionHash<Container, Const_IT>(second.begin(), second.end(),
+                                                              first.begin(), first.end(), true)));
+}
+
+// Test intersections of elements only providing operator<
+TEST(TestIntersection, OrderedKeys)
+{
+  typedef std::vector<OrderedKey> Keys;
+  auto lKeys = [](const int* begin, const int* end)
+  {
+    Keys keys;
+    for (auto it = begin; it != end; ++it)
+      keys.push_back(OrderedKey(*it));
+    return keys;
+  };
+  auto lValues = [](const Keys& keys)
+  {
+    Container values;
+    for (auto it = keys.begin(); it != keys.end(); ++it)
+      values.push_back(it->key);
+    std::sort(values.begin(), values.end());
+    return values;
+  };
+
+  // Unsorted sequences - ordered multiset used instead of a hash table
+  {
+    const auto kFirst = lKeys(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
+    const auto kSecond =
+      lKeys(RandomArrayInterInt, RandomArrayInterInt + sizeof(RandomArrayInterInt) / sizeof(Value));
+    const auto kIntersection = Intersection<Keys, Keys::const_iterator>(kFirst.begin(), kFirst.end(),
+                                                                         kSecond.begin(), kSecond.end());
+    const int kExpected[] = {-18, -5, 3, 5, 5};
+    EXPECT_EQ(Container(kExpected, kExpected + 5), lValues(kIntersection));
+  }
+
+  // Sorted sequences - merged
+  {
+    const int kOther[] = {-2, 2, 3, 15, 400};
+    const auto kFirst = lKeys(SortedArrayInt, SortedArrayInt + sizeof(SortedArrayInt) / sizeof(Value));
+    const auto kSecond = lKeys(kOther, kOther + 5);
+    const auto kIntersection = Intersection<Keys, Keys::const_iterator>(kFirst.begin(), kFirst.end(),
+                                                                         kSecond.begin(), kSecond.end());
+    const int kExpected[] = {-2, 2, 15};
+    EXPECT_EQ(Container(kExpected, kExpected + 3), lValues(kIntersection));
+  }
+}
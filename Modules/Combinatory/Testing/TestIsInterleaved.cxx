@@ -20,6 +20,11 @@
 #include <gtest/gtest.h>
 #include <is_interleaved.hxx>
 
+// STD includes
+#include <random>
+#include <string>
+#include <vector>
+
 using namespace huc::combinatory;
 
 #ifndef DOXYGEN_SKIP
@@ -35,6 +40,30 @@ namespace {
   typedef std::vector<int> Container;
   typedef Container::value_type Value;
   typedef Container::iterator IT;
+
+  // Reference quadratic dynamic programming for ordered interleaves
+  bool IsOrderedInterleaveReference(const Container& a, const Container& b, const Container& c)
+  {
+    if (a.size() + b.size() != c.size())
+      return false;
+
+    std::vector<std::vector<bool>> dp(a.size() + 1, std::vector<bool>(b.size() + 1, false));
+    for (std::size_t i = 0; i <= a.size(); ++i)
+      for (std::size_t j = 0; j <= b.size(); ++j)
+        dp[i][j] = (i == 0 && j == 0) ||
+                   (i > 0 && dp[i - 1][j] && a[i - 1] == c[i + j - 1]) ||
+                   (j > 0 && dp[i][j - 1] && b[j - 1] == c[i + j - 1]);
+    return dp[a.size()][b.size()];
+  }
+
+  // Key only providing operator< (no std::hash, operator== nor default constructor)
+  struct OrderedKey
+  {
+    explicit OrderedKey(int key) : key(key) {}
+    bool operator<(const OrderedKey& other) const { return this->key < other.key; }
+
+    int key;
+  };
 }
 #endif /* DOXYGEN_SKIP */
 
@@ -96,3 +125,127 @@ TEST(TestIsInterleaved, Interleaved)
       bStr.end(), cStr.begin(), cStr.end()));
   }
 }
+
+// Test interleaves counting paths
+TEST(TestIsInterleaved, Counting)
+{
+  // Small integral type - direct-indexed histograms
+  {
+    const std::vector<char> kFirst = {'a', -3, 'z', 127};
+    const std::vector<char> kSecond = {-128, 'a', 0};
+    const std::vector<char> kFull = {0, 'a', 127, -128, 'z', 'a', -3};
+    const std::vector<char> kWrong = {0, 'a', 127, -128, 'z', 'z', -3};
+    typedef std::vector<char>::const_iterator Char_IT;
+    EXPECT_TRUE(IsInterleaved<Char_IT>(kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end(),
+                                       kFull.begin(), kFull.end()));
+    EXPECT_FALSE(IsInterleaved<Char_IT>(kFirst.begin(), kFirst.end(), kSecond.begin(), kSecond.end(),
+                                        kWrong.begin(), kWrong.end()));
+  }
+
+  // Missing element
+  {
+    Container sequenceA(kSequenceAInt, kSequenceAInt + sizeof(kSequenceAInt) / sizeof(Value));
+    Container sequenceB(kSequenceBInt, kSequenceBInt + sizeof(kSequenceBInt) / sizeof(Value));
+    Container sequenceC(kSequenceCInt, kSequenceCInt + sizeof(kSequenceCInt) / sizeof(Value));
+    sequenceC.back() = 42;
+    EXPECT_FALSE(IsInterleaved<IT>(sequenceA.begin(), sequenceA.end(), sequenceB.begin(),
+      sequenceB.end(), sequenceC.begin(), sequenceC.end()));
+  }
+}
+
+// Test interleaves preserving the order of both sequences
+TEST(TestIsInterleaved, OrderedInterleave)
+{
+  // Same elements but not in order
+  {
+    Container sequenceA(kSequenceAInt, kSequenceAInt + sizeof(kSequenceAInt) / sizeof(Value));
+    Container sequenceB(kSequenceBInt, kSequenceBInt + sizeof(kSequenceBInt) / sizeof(Value));
+    Container sequenceC(kSequenceCInt, kSequenceCInt + sizeof(kSequenceCInt) / sizeof(Value));
+    EXPECT_FALSE(IsOrderedInterleave<IT>(sequenceA.begin(), sequenceA.end(), sequenceB.begin(),
+      sequenceB.end(), sequenceC.begin(), sequenceC.end()));
+  }
+
+  // Strings
+  {
+    std::string aStr = "aabcc";
+    std::string bStr = "dbbca";
+    std::string cStr = "aadbbcbcac";
+    std::string wrongStr = "aadbbbaccc";
+    typedef std::string::iterator String_IT;
+    EXPECT_TRUE(IsOrderedInterleave<String_IT>(aStr.begin(), aStr.end(), bStr.begin(), bStr.end(),
+                                               cStr.begin(), cStr.end()));
+    EXPECT_TRUE(IsOrderedInterleave<String_IT>(bStr.begin(), bStr.end(), aStr.begin(), aStr.end(),
+                                               cStr.begin(), cStr.end()));
+    EXPECT_FALSE(IsOrderedInterleave<String_IT>(aStr.begin(), aStr.end(), bStr.begin(), bStr.end(),
+                                                wrongStr.begin(), wrongStr.end()));
+    EXPECT_TRUE(IsOrderedInterleave<String_IT>(aStr.begin(), aStr.end(), aStr.end(), aStr.end(),
+                                               aStr.begin(), aStr.end()));
+  }
+
+  // Random interleaves over small alphabets (many ambiguities) spanning several words, per element
+  // bitsets being used up to 64 distinct elements, elements comparisons beyond
+  std::mt19937 generator(17);
+  const std::size_t kSizes[] = {0, 1, 5, 63, 64, 65, 130, 300};
+  const unsigned int kRareValues[] = {0, 200};
+  for (auto rareValues : kRareValues)
+  {
+    auto lValue = [&]()
+    {
+      return static_cast<int>((rareValues > 0 && generator() % 4 == 0) ? 2 + generator() % rareValues
+                                                                        : generator() % 2);
+    };
+
+    for (auto firstSize : kSizes)
+    {
+      for (auto secondSize : kSizes)
+      {
+        Container first(firstSize), second(secondSize), full;
+        for (auto it = first.begin(); it != first.end(); ++it)
+          *it = lValue();
+        for (auto it = second.begin(); it != second.end(); ++it)
+          *it = lValue();
+        for (std::size_t i = 0, j = 0; i + j < firstSize + secondSize; )
+          full.push_back((j == secondSize || (i < firstSize && generator() % 2)) ? first[i++] : second[j++]);
+
+        EXPECT_TRUE(IsOrderedInterleave<IT>(first.begin(), first.end(), second.begin(), second.end(),
+                                            full.begin(), full.end()));
+
+        // Altered interleaves
+        for (int alteration = 0; alteration < 4 && !full.empty(); ++alteration)
+        {
+          Container altered(full);
+          altered[generator() % altered.size()] ^= 1;
+          std::swap(altered[generator() % altered.size()], altered[generator() % altered.size()]);
+          EXPECT_EQ(IsOrderedInterleaveReference(first, second, altered),
+                    IsOrderedInterleave<IT>(first.begin(), first.end(), second.begin(), second.end(),
+                                            altered.begin(), altered.end()));
+        }
+      }
+    }
+  }
+}
+
+// Test interleaves of elements only providing operator<
+TEST(TestIsInterleaved, OrderedKeys)
+{
+  typedef std::vector<OrderedKey> Keys;
+  auto lKeys = [](const int* begin, const int* end)
+  {
+    Keys keys;
+    for (auto it = begin; it != end; ++it)
+      keys.push_back(OrderedKey(*it));
+    return keys;
+  };
+
+  const auto kSequenceA = lKeys(kSequenceAInt, kSequenceAInt + sizeof(kSequenceAInt) / sizeof(Value));
+  const auto kSequenceB = lKeys(kSequenceBInt, kSequenceBInt + sizeof(kSequenceBInt) / sizeof(Value));
+  const auto kSequenceC = lKeys(kSequenceCInt, kSequenceCInt + sizeof(kSequenceCInt) / sizeof(Value));
+  auto sequenceWrong = kSequenceC;
+  sequenceWrong.back() = OrderedKey(42);
+
+  typedef Keys::const_iterator Keys_IT;
+  EXPECT_TRUE(IsInterleaved<Keys_IT>(kSequenceA.begin(), kSequenceA.end(), kSequenceB.begin(),
+    kSequenceB.end(), kSequenceC.begin(), kSequenceC.end()));
+  EXPECT_FALSE(IsInterleaved<Keys_IT>(kSequenceA.begin(), kSequenceA.end(), kSequenceB.begin(),
+    kSequenceB.end(), sequenceWrong.cbegin(), sequenceWrong.cend()));
+}
@@ -20,6 +20,13 @@
 #include <gtest/gtest.h>
 #include <permutations.hxx>
 
+// STD includes
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
 using namespace huc::combinatory;
 
 #ifndef DOXYGEN_SKIP
@@ -90,3 +97,246 @@ TEST(TestCore, Permutations)
       EXPECT_EQ(3, it->size());
   }
 }
+
+// Test lazy permutations using Heap's algorithm
+TEST(TestCore, HeapPermutations)
+{
+  // Empty sequence - no permutations
+  {
+    Container emptyCollection;
+    HeapPermutations<Container::iterator> permutations(emptyCollection.begin(), emptyCollection.end());
+    EXPECT_TRUE(permutations.begin() == permutations.end());
+    EXPECT_FALSE(permutations.Next());
+  }
+
+  // Unic element - Unique permutation
+  {
+    Container unicCollection(1, 10);
+    HeapPermutations<Container::iterator> permutations(unicCollection.begin(), unicCollection.end());
+    int count = 0;
+    for (auto it = permutations.begin(); it != permutations.end(); ++it, ++count)
+      EXPECT_EQ(10, (*it)[0]);
+    EXPECT_EQ(1, count);
+  }
+
+  // n! distinct permutations, each one obtained by a single swap
+  for (int n = 2; n <= 7; ++n)
+  {
+    Container sequence(n);
+    for (int i = 0; i < n; ++i)
+      sequence[i] = i;
+
+    std::set<Container> visited;
+    Container previous = sequence;
+    HeapPermutations<Container::iterator> permutations(sequence.begin(), sequence.end());
+    for (auto it = permutations.begin(); it != permutations.end(); ++it)
+    {
+      const Container kPermutation((*it).begin(), (*it).end());
+      int differences = 0;
+      for (int i = 0; i < n; ++i)
+        differences += (kPermutation[i] != previous[i]) ? 1 : 0;
+      EXPECT_TRUE(visited.empty() || differences == 2);
+
+      visited.insert(kPermutation);
+      previous = kPermutation;
+    }
+
+    std::size_t factorial = 1;
+    for (int i = 2; i <= n; ++i)
+      factorial *= i;
+    EXPECT_EQ(factorial, visited.size());
+  }
+
+  // Same permutations as Permutations, stopping early using Next
+  {
+    const std::string kAbcStr = "abcd";
+    const auto kPermutations = Permutations<std::string, std::string::const_iterator>(kAbcStr.begin(),
+                                                                                      kAbcStr.end());
+    const std::set<std::string> kExpected(kPermutations.begin(), kPermutations.end());
+
+    std::string sequence = kAbcStr;
+    std::set<std::string> visited;
+    HeapPermutations<std::string::iterator> permutations(sequence.begin(), sequence.end());
+    do { visited.insert(sequence); } while (permutations.Next());
+    EXPECT_EQ(kExpected, visited);
+
+    sequence = kAbcStr;
+    HeapPermutations<std::string::iterator> partial(sequence.begin(), sequence.end());
+    int count = 0;
+    for (auto it = partial.begin(); it != partial.end() && count < 5; ++it)
+      ++count;
+    EXPECT_EQ(5, count);
+  }
+
+#ifdef HUC_COMBINATORY_COROUTINES
+  // Coroutine facade - same permutations as the iterator
+  {
+    Container sequence = {1, 2, 3, 4};
+    std::set<Container> visited;
+    for (const auto& permutation : LazyPermutations(sequence.begin(), sequence.end()))
+      visited.insert(Container(permutation.begin(), permutation.end()));
+    EXPECT_EQ(static_cast<std::size_t>(24), visited.size());
+  }
+#endif
+}
+
+// Test permutations rank and unrank
+TEST(TestCore, PermutationRank)
+{
+  EXPECT_EQ(1u, Factorial(0));
+  EXPECT_EQ(3628800u, Factorial(10));
+  EXPECT_EQ(2432902008176640000u, Factorial(20));
+  EXPECT_EQ(0u, Factorial(21));
+
+  // Ranks follow the lexicographic order of std::next_permutation
+  {
+    Container sequence = {1, 2, 3, 4, 5};
+    unsigned long long rank = 0;
+    do
+    {
+      EXPECT_EQ(rank, PermutationRank(sequence.begin(), sequence.end()));
+
+      Container unranked = {1, 2, 3, 4, 5};
+      EXPECT_TRUE(PermutationUnrank(unranked.begin(), unranked.end(), rank));
+      EXPECT_EQ(sequence, unranked);
+      ++rank;
+    } while (std::next_permutation(sequence.begin(), sequence.end()));
+    EXPECT_EQ(120u, rank);
+  }
+
+  // Out of range ranks and empty sequences
+  {
+    Container sequence = {1, 2, 3};
+    EXPECT_FALSE(PermutationUnrank(sequence.begin(), sequence.end(), 6));
+    EXPECT_EQ(Container({1, 2, 3}), sequence);
+    EXPECT_FALSE(PermutationUnrank(sequence.begin(), sequence.begin(), 0));
+    EXPECT_EQ(0u, PermutationRank(sequence.begin(), sequence.begin()));
+  }
+
+  // Last permutation of 20 elements
+  {
+    Container sequence(20);
+    for (int i = 0; i < 20; ++i)
+      sequence[i] = i;
+    EXPECT_TRUE(PermutationUnrank(sequence.begin(), sequence.end(), Factorial(20) - 1));
+    EXPECT_TRUE(std::is_sorted(sequence.rbegin(), sequence.rend()));
+    EXPECT_EQ(Factorial(20) - 1, PermutationRank(sequence.begin(), sequence.end()));
+  }
+}
+
+// Test permutations visited using several threads
+TEST(TestCore, ParallelForEachPermutation)
+{
+  // Empty sequence - no permutations
+  {
+    Container emptyCollection;
+    EXPECT_FALSE(ParallelForEachPermutation(emptyCollection.begin(), emptyCollection.end(),
+                                            [](const PermutationView<Const_IT>&) {}));
+  }
+
+  // Each permutation is visited exactly once
+  const unsigned int kThreads[] = {1, 3, 4, 64};
+  for (auto threads = std::begin(kThreads); threads != std::end(kThreads); ++threads)
+  {
+    const Container kSequence = {0, 1, 2, 3, 4, 5, 6};
+    std::vector<int> visits(Factorial(7), 0);
+    std::mutex mutex;
+    EXPECT_TRUE(ParallelForEachPermutation(kSequence.begin(), kSequence.end(),
+      [&](const PermutationView<Const_IT>& permutation)
+      {
+        const auto kRank = PermutationRank(permutation.begin(), permutation.end());
+        std::lock_guard<std::mutex> lock(mutex);
+        ++visits[kRank];
+      }, *threads));
+    EXPECT_EQ(visits.size(), static_cast<std::size_t>(std::count(visits.begin(), visits.end(), 1)));
+  }
+
+  // Unordered elements are permuted according to their positions
+  {
+    const std::string kStr = "cab";
+    std::set<std::string> visited;
+    std::mutex mutex;
+    ParallelForEachPermutation(kStr.begin(), kStr.end(),
+      [&](const PermutationView<std::vector<char>::const_iterator>& permutation)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        visited.insert(std::string(permutation.begin(), permutation.end()));
+      }, 2);
+    EXPECT_EQ(static_cast<std::size_t>(6), visited.size());
+  }
+}
+
+// Test distinct permutations of sequences containing equal elements
+TEST(TestCore, MultisetPermutations)
+{
+  // Empty sequence - no permutations
+  {
+    Container emptyCollection;
+    MultisetPermutations<Container::iterator> permutations(emptyCollection.begin(), emptyCollection.end());
+    EXPECT_TRUE(permutations.begin() == permutations.end());
+    EXPECT_EQ(1u, MultisetPermutationsCount(emptyCollection.begin(), emptyCollection.end()));
+  }
+
+  // Same elements - Unique permutation
+  {
+    Container sameElCollection(5, 10);
+    MultisetPermutations<Container::iterator> permutations(sameElCollection.begin(), sameElCollection.end());
+    int count = 0;
+    for (auto it = permutations.begin(); it != permutations.end(); ++it)
+      ++count;
+    EXPECT_EQ(1, count);
+    EXPECT_EQ(1u, MultisetPermutationsCount(sameElCollection.begin(), sameElCollection.end()));
+  }
+
+  // Each distinct permutation visited once, in lexicographic order, same set as Permutations
+  {
+    const std::string kStrs[] = {"abc", "aabb", "baaac", "mississippi"};
+    for (auto kStr = std::begin(kStrs); kStr != std::end(kStrs); ++kStr)
+    {
+      std::string sequence = *kStr;
+      std::vector<std::string> visited;
+      MultisetPermutations<std::string::iterator> permutations(sequence.begin(), sequence.end());
+      for (auto it = permutations.begin(); it != permutations.end(); ++it)
+        visited.push_back(std::string((*it).begin(), (*it).end()));
+
+      EXPECT_TRUE(std::is_sorted(visited.begin(), visited.end()));
+      EXPECT_TRUE(std::adjacent_find(visited.begin(), visited.end()) == visited.end());
+      EXPECT_EQ(MultisetPermutationsCount(kStr->begin(), kStr->end()), visited.size());
+      EXPECT_TRUE(std::is_sorted(sequence.begin(), sequence.end()));
+
+      if (kStr->size() < 6)
+      {
+        const auto kPermutations = Permutations<std::string, std::string::const_iterator>(kStr->begin(),
+                                                                                          kStr->end());
+        EXPECT_EQ(std::set<std::string>(kPermutations.begin(), kPermutations.end()),
+                  std::set<std::string>(visited.begin(), visited.end()));
+      }
+    }
+  }
+
+  // Multinomial coefficients
+  {
+    const std::string kMississippi = "mississippi";
+    EXPECT_EQ(34650u, MultisetPermutationsCount(kMississippi.begin(), kMississippi.end()));
+
+    Container sequence(40);
+    for (int i = 0; i < 40; ++i)
+      sequence[i] = i % 2;
+    EXPECT_EQ(137846528820u, MultisetPermutationsCount(sequence.begin(), sequence.end()));
+
+    for (int i = 0; i < 40; ++i)
+      sequence[i] = i;
+    EXPECT_EQ(0u, MultisetPermutationsCount(sequence.begin(), sequence.end()));
+  }
+
+#ifdef HUC_COMBINATORY_COROUTINES
+  // Coroutine facade - same permutations as the iterator
+  {
+    std::string sequence = "aabb";
+    std::set<std::string> visited;
+    for (const auto& permutation : LazyMultisetPermutations(sequence.begin(), sequence.end()))
+      visited.insert(std::string(permutation.begin(), permutation.end()));
+    EXPECT_EQ(static_cast<std::size_t>(6), visited.size());
+  }
+#endif
+}
@@ -0,0 +1,157 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <set_operations.hxx>
+
+// STD includes
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace huc::combinatory;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  typedef std::vector<int> Container;
+  typedef Container::const_iterator Const_IT;
+  typedef std::vector<std::pair<Const_IT, Const_IT>> Ranges;
+
+  // Sorted sequences of random keys within [0, maxKey] (dupplicates included)
+  std::vector<Container> RandomSequences(std::mt19937& generator, const std::vector<int>& sizes, int maxKey)
+  {
+    std::uniform_int_distribution<int> distribution(0, maxKey);
+    std::vector<Container> sequences;
+    for (auto size = sizes.begin(); size != sizes.end(); ++size)
+    {
+      Container sequence(*size);
+      for (auto it = sequence.begin(); it != sequence.end(); ++it)
+        *it = distribution(generator);
+      std::sort(sequence.begin(), sequence.end());
+      sequences.push_back(sequence);
+    }
+    return sequences;
+  }
+
+  Ranges ToRanges(const std::vector<Container>& sequences)
+  {
+    Ranges ranges;
+    for (auto it = sequences.begin(); it != sequences.end(); ++it)
+      ranges.push_back(std::make_pair(it->begin(), it->end()));
+    return ranges;
+  }
+
+  // Reference results computed with the pairwise standard set operations
+  enum Operation { kIntersection, kUnion, kDifference };
+  Container Reference(const std::vector<Container>& sequences, Operation operation)
+  {
+    Container result = sequences.front();
+    for (auto it = sequences.begin() + 1; it != sequences.end(); ++it)
+    {
+      Container next;
+      if (operation == kIntersection)
+        std::set_intersection(result.begin(), result.end(), it->begin(), it->end(), std::back_inserter(next));
+      else if (operation == kUnion)
+        std::set_union(result.begin(), result.end(), it->begin(), it->end(), std::back_inserter(next));
+      else
+        std::set_difference(result.begin(), result.end(), it->begin(), it->end(), std::back_inserter(next));
+      result.swap(next);
+    }
+    return result;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test k-way set operations
+TEST(TestSetOperations, SetOperations)
+{
+  // No sequences - empty result
+  {
+    Container result;
+    const Ranges kNoRanges;
+    Intersection(kNoRanges, std::back_inserter(result));
+    Union(kNoRanges, std::back_inserter(result));
+    Difference(kNoRanges, std::back_inserter(result));
+    EXPECT_TRUE(result.empty());
+  }
+
+  // Basic run with dupplicates
+  {
+    const std::vector<Container> kSequences = {{1, 2, 2, 2, 5, 7, 9}, {2, 2, 5, 6, 9, 9}, {0, 2, 2, 5, 9}};
+    const Container kIntersection = {2, 2, 5, 9};
+    const Container kUnion = {0, 1, 2, 2, 2, 5, 6, 7, 9, 9};
+    const Container kDifference = {1, 7};
+
+    Container result;
+    Intersection(ToRanges(kSequences), std::back_inserter(result));
+    EXPECT_EQ(kIntersection, result);
+    result.clear();
+    Union(ToRanges(kSequences), std::back_inserter(result));
+    EXPECT_EQ(kUnion, result);
+    result.clear();
+    Difference(ToRanges(kSequences), std::back_inserter(result));
+    EXPECT_EQ(kDifference, result);
+  }
+
+  // Random sequences against the pairwise standard operations
+  std::mt19937 generator(11);
+  const std::vector<int> kSizes[] =
+    {{0, 10}, {50}, {100, 3, 1000}, {400, 500, 50, 600, 2000}, {20, 20, 20, 20}};
+  for (auto sizes : kSizes)
+  {
+    const auto kSequences = RandomSequences(generator, sizes, 300);
+    Container result;
+    Intersection(ToRanges(kSequences), std::back_inserter(result));
+    EXPECT_EQ(Reference(kSequences, kIntersection), result);
+    result.clear();
+    Union(ToRanges(kSequences), std::back_inserter(result));
+    EXPECT_EQ(Reference(kSequences, kUnion), result);
+    result.clear();
+    Difference(ToRanges(kSequences), std::back_inserter(result));
+    EXPECT_EQ(Reference(kSequences, kDifference), result);
+  }
+}
+
+// Test parallel k-way set operations
+TEST(TestSetOperations, ParallelSetOperations)
+{
+  std::mt19937 generator(13);
+  const auto kSequences = RandomSequences(generator, {60000, 30000, 100000}, 50000);
+  const auto kRanges = ToRanges(kSequences);
+  for (unsigned int threads = 1; threads <= 4; ++threads)
+  {
+    Container result;
+    ParallelIntersection(kRanges, std::back_inserter(result), threads);
+    EXPECT_EQ(Reference(kSequences, kIntersection), result);
+    result.clear();
+    ParallelUnion(kRanges, std::back_inserter(result), threads);
+    EXPECT_EQ(Reference(kSequences, kUnion), result);
+    result.clear();
+    ParallelDifference(kRanges, std::back_inserter(result), threads);
+    EXPECT_EQ(Reference(kSequences, kDifference), result);
+  }
+
+  // Output written through a raw iterator
+  Container result(kSequences[1].size());
+  const auto kEnd = ParallelIntersection(kRanges, result.begin(), 3);
+  result.erase(kEnd, result.end());
+  EXPECT_EQ(Reference(kSequences, kIntersection), result);
+}
@@ -21,7 +21,12 @@
 #define MODULE_COMBINATORY_COMBINATIONS_HXX
 
 // STD includes
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <list>
+#include <vector>
 
 namespace huc
 {
@@ -32,6 +37,7 @@ namespace huc
     /// @remark a vector is not recommended as type for the Output_Container to avoid stack overflow as well
     /// as extra complexity due to frequent resizing (use instead structure such as list or a another with
     /// your own allocator).
+    /// @remark use GraySubsets or KCombinations to visit the subsets without storing them.
     ///
     /// @tparam Container type of IT type.
     /// @tparam IT type using to go through the collection.
@@ -73,6 +79,501 @@ namespace huc
 
       return combinations;
     }
+
+    /// Lowest Bit Index - Index of the lowest bit set of a non-null word.
+    inline unsigned int LowestBitIndex(std::uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+      unsigned int index = 0;
+      for (; (word & 1) == 0; word >>= 1)
+        ++index;
+      return index;
+#endif
+    }
+
+    /// Highest Bit Index - Index of the highest bit set of a non-null word.
+    inline unsigned int HighestBitIndex(std::uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return 63 - static_cast<unsigned int>(__builtin_clzll(word));
+#else
+      unsigned int index = 0;
+      for (; word > 1; word >>= 1)
+        ++index;
+      return index;
+#endif
+    }
+
+    /// Bit Count - Number of bits set of a word.
+    inline unsigned int BitCount(std::uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<unsigned int>(__builtin_popcountll(word));
+#else
+      unsigned int count = 0;
+      for (; word != 0; word &= word - 1)
+        ++count;
+      return count;
+#endif
+    }
+
+    /// Gcd - Greatest common divisor using Euclid's algorithm.
+    inline unsigned long long Gcd(unsigned long long a, unsigned long long b)
+    {
+      while (b != 0)
+      {
+        const auto kRemainder = a % b;
+        a = b;
+        b = kRemainder;
+      }
+      return a;
+    }
+
+    /// Binomial - Number of k-combinations of n elements C(n, k).
+    ///
+    /// @complexity O(k).
+    ///
+    /// @return C(n, k), 0 if k > n or if it cannot be represented using 64 bits.
+    inline unsigned long long Binomial(unsigned int n, unsigned int k)
+    {
+      if (k > n)
+        return 0;
+      if (k > n - k)
+        k = n - k;
+
+      // binomial * (n - k + i) / i is exact: divide by the common factors first
+      unsigned long long binomial = 1;
+      for (unsigned long long i = 1; i <= k; ++i)
+      {
+        const auto kGcd = Gcd(binomial, i);
+        binomial /= kGcd;
+        const auto kNumerator = (n - k + i) / (i / kGcd);
+        if (binomial > std::numeric_limits<unsigned long long>::max() / kNumerator)
+          return 0;
+        binomial *= kNumerator;
+      }
+      return binomial;
+    }
+
+    /// @class SubsetView
+    ///
+    /// Non-owning view on the elements of a sequence selected by a 64 bits mask (bit i for element i).
+    ///
+    /// @tparam IT random-access iterator type using to go through the collection.
+    template <typename IT>
+    class SubsetView
+    {
+    public:
+      /// Iterator - Forward iterator over the selected elements, in sequence order.
+      class Iterator
+      {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename std::iterator_traits<IT>::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::iterator_traits<IT>::pointer pointer;
+        typedef typename std::iterator_traits<IT>::reference reference;
+
+        Iterator(const IT& first, std::uint64_t mask) : first(first), mask(mask) {}
+
+        reference operator*() const { return *(this->first + LowestBitIndex(this->mask)); }
+        Iterator& operator++()
+        {
+          this->mask &= this->mask - 1;
+          return *this;
+        }
+        bool operator==(const Iterator& other) const { return this->mask == other.mask; }
+        bool operator!=(const Iterator& other) const { return this->mask != other.mask; }
+
+      private:
+        IT first;
+        std::uint64_t mask;  // Elements remaining to be visited
+      };
+
+      SubsetView(const IT& first, std::uint64_t mask) : first(first), mask(mask) {}
+
+      Iterator begin() const { return Iterator(this->first, this->mask); }
+      Iterator end() const { return Iterator(this->first, 0); }
+      std::size_t size() const { return BitCount(this->mask); }
+
+    private:
+      IT first;
+      std::uint64_t mask;
+    };
+
+    /// Combination Masks - Compact version of Combinations: all possible combinations of elements
+    /// containing within the sequence as a contiguous collection of masks (bit i for element i).
+    ///
+    /// @remark masks are ordered the same way as the subsets returned by Combinations, use SubsetView to
+    /// go through the elements of a mask.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of
+    /// the sequence. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @complexity O(2^n) using a single allocation.
+    ///
+    /// @return the 2^n - 1 masks of the non-empty subsets, nothing if the sequence holds 64 elements or more.
+    template <typename IT>
+    std::vector<std::uint64_t> CombinationMasks(const IT& begin, const IT& end)
+    {
+      std::vector<std::uint64_t> masks;
+      const auto kSeqSize = static_cast<int>(std::distance(begin, end));
+      if (kSeqSize <= 0 || kSeqSize >= 64)
+        return masks;
+
+      // Same construction as Combinations, from the last element to the first one: each mask of the
+      // suffix is followed by itself plus the new element, moved in place from the back of the buffer.
+      masks.reserve((1ull << kSeqSize) - 1);
+      masks.push_back(1ull << (kSeqSize - 1));
+      for (auto i = kSeqSize - 2; i >= 0; --i)
+      {
+        const auto kBit = 1ull << i;
+        const auto kSize = masks.size();
+        masks.resize(2 * kSize + 1);
+        for (auto j = kSize; j > 0; --j)
+        {
+          masks[2 * j] = masks[j - 1] | kBit;
+          masks[2 * j - 1] = masks[j - 1];
+        }
+        masks[0] = kBit;
+      }
+
+      return masks;
+    }
+
+    /// @class FlatCombinations
+    ///
+    /// Compact version of Combinations: all the subsets are stored within a unique buffer of elements
+    /// (Compressed Sparse Row layout), the subset i being [offsets[i], offsets[i + 1]) of the buffer.
+    ///
+    /// FlatCombinations<IT> combinations(begin, end);
+    /// for (auto it = combinations.begin(); it != combinations.end(); ++it)
+    ///   for (auto element = it->begin(); element != it->end(); ++element) ...
+    ///
+    /// @advantages
+    /// - Two allocations instead of one per subset, elements of consecutive subsets are contiguous.
+    /// - Subsets and their elements are ordered the same way as the ones returned by Combinations.
+    ///
+    /// @drawbacks
+    /// - Sequences of 64 elements or more are not supported (empty result).
+    ///
+    /// @tparam IT type using to go through the collection.
+    template <typename IT>
+    class FlatCombinations
+    {
+    public:
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef typename std::vector<Value>::const_iterator Const_IT;
+
+      /// View - Non-owning view on the elements of a subset.
+      class View
+      {
+      public:
+        View(const Const_IT& first, const Const_IT& last) : first(first), last(last) {}
+
+        Const_IT begin() const { return this->first; }
+        Const_IT end() const { return this->last; }
+        std::size_t size() const { return static_cast<std::size_t>(std::distance(this->first, this->last)); }
+        const Value& operator[](std::size_t i) const { return *(this->first + i); }
+
+      private:
+        Const_IT first;
+        Const_IT last;
+      };
+
+      /// Iterator - Forward iterator over the subsets.
+      class Iterator
+      {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef View value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const View* pointer;
+        typedef View reference;
+
+        Iterator(const FlatCombinations* combinations, std::size_t index) :
+          combinations(combinations), index(index), view((*combinations)[index]) {}
+
+        View operator*() const { return this->view; }
+        const View* operator->() const { return &this->view; }
+        Iterator& operator++()
+        {
+          this->view = (*this->combinations)[++this->index];
+          return *this;
+        }
+        bool operator==(const Iterator& other) const { return this->index == other.index; }
+        bool operator!=(const Iterator& other) const { return this->index != other.index; }
+
+      private:
+        const FlatCombinations* combinations;
+        std::size_t index;
+        View view;
+      };
+
+      /// @param begin,end - iterators to the initial and final positions of
+      /// the sequence. The range used is [first,last), which contains all the elements between
+      /// first and last, including the element pointed by first but not the element pointed by last.
+      ///
+      /// @complexity O(n * 2^n).
+      FlatCombinations(const IT& begin, const IT& end) : offsets(1, 0)
+      {
+        const auto kMasks = CombinationMasks(begin, end);
+        this->offsets.reserve(kMasks.size() + 1);
+        for (auto it = kMasks.begin(); it != kMasks.end(); ++it)
+          this->offsets.push_back(this->offsets.back() + BitCount(*it));
+
+        // Elements of a subset are ordered by decreasing position, as built by Combinations
+        this->elements.reserve(this->offsets.back());
+        for (auto it = kMasks.begin(); it != kMasks.end(); ++it)
+          for (auto mask = *it; mask != 0; mask &= ~(1ull << HighestBitIndex(mask)))
+            this->elements.push_back(*(begin + HighestBitIndex(mask)));
+      }
+
+      /// @return the number of subsets.
+      std::size_t Size() const { return this->offsets.size() - 1; }
+
+      /// @return the subset i, an empty view if i >= Size().
+      View operator[](std::size_t i) const
+      {
+        if (i >= this->Size())
+          return View(this->elements.end(), this->elements.end());
+        return View(this->elements.begin() + this->offsets[i], this->elements.begin() + this->offsets[i + 1]);
+      }
+
+      Iterator begin() const { return Iterator(this, 0); }
+      Iterator end() const { return Iterator(this, this->Size()); }
+
+      /// @return the buffer of elements of all the subsets.
+      const std::vector<Value>& Elements() const { return this->elements; }
+
+      /// @return the offsets of the subsets within the buffer of elements (Size() + 1 values).
+      const std::vector<std::size_t>& Offsets() const { return this->offsets; }
+
+    private:
+      std::vector<std::size_t> offsets;  // Subset i is [offsets[i], offsets[i + 1]) of the elements
+      std::vector<Value> elements;       // Elements of all the subsets
+    };
+
+    /// Gray Code Unrank - Subset visited at the given rank in Gray code order.
+    inline std::uint64_t GrayCodeUnrank(unsigned long long rank) { return rank ^ (rank >> 1); }
+
+    /// Gray Code Rank - Rank of the subset in Gray code order.
+    inline unsigned long long GrayCodeRank(std::uint64_t mask)
+    {
+      for (auto shift = 1u; shift < 64; shift <<= 1)
+        mask ^= mask >> shift;
+      return mask;
+    }
+
+    /// @class GraySubsets
+    ///
+    /// Lazy enumeration of the 2^n subsets of n elements (n <= 64) in Gray code order: each subset is
+    /// obtained from the previous one by adding or removing a single element, starting from the empty set.
+    ///
+    /// for (GraySubsets subsets(n); subsets.IsValid(); subsets.Next())
+    ///   Use(subsets.Mask()); // or SubsetView<IT>(begin, subsets.Mask())
+    ///
+    /// @advantages
+    /// - O(1) per subset, no allocation.
+    /// - Subsets can be split across threads by starting each one at a given rank.
+    class GraySubsets
+    {
+    public:
+      /// @param n number of elements (64 at most).
+      /// @param rank rank of the first subset to be visited.
+      explicit GraySubsets(unsigned int n, unsigned long long rank = 0) :
+        n(n), rank(rank), mask(GrayCodeUnrank(rank)), changed(-1),
+        valid(n <= 64 && (n == 64 || rank < (1ull << n))) {}
+
+      /// Next - Move to the next subset.
+      ///
+      /// @complexity O(1).
+      ///
+      /// @return false once all the subsets have been visited, true otherwise.
+      bool Next()
+      {
+        if (!this->valid)
+          return false;
+
+        ++this->rank;
+        if (this->rank == 0 || (this->n < 64 && this->rank == (1ull << this->n)))
+          return this->valid = false;
+
+        this->changed = static_cast<int>(LowestBitIndex(this->rank));
+        this->mask ^= 1ull << this->changed;
+        return true;
+      }
+
+      /// @return true while the current subset is a valid one.
+      bool IsValid() const { return this->valid; }
+
+      /// @return the current subset.
+      std::uint64_t Mask() const { return this->mask; }
+
+      /// @return the element added or removed by the last call to Next, -1 before.
+      int Changed() const { return this->changed; }
+
+      /// @return the rank of the current subset.
+      unsigned long long Rank() const { return this->rank; }
+
+    private:
+      unsigned int n;           // Number of elements
+      unsigned long long rank;  // Rank of the current subset
+      std::uint64_t mask;       // Current subset
+      int changed;              // Element changed by the last move
+      bool valid;               // Whether the current subset is valid
+    };
+
+    /// Combination Rank - Rank of the k-combination in colexicographic order (combinatorial number
+    /// system), which is the order of KCombinations.
+    ///
+    /// @param mask the combination, bit i for element i.
+    ///
+    /// @complexity O(k).
+    inline unsigned long long CombinationRank(std::uint64_t mask)
+    {
+      unsigned long long rank = 0;
+      for (unsigned int i = 1; mask != 0; mask &= mask - 1, ++i)
+        rank += Binomial(LowestBitIndex(mask), i);
+      return rank;
+    }
+
+    /// Combination Unrank Position - Greatest position c < n such that C(c, i) <= rank, the rank being
+    /// decreased by C(c, i): position of the ith element of the combination of the given rank.
+    inline unsigned int CombinationUnrankPosition(unsigned long long& rank, unsigned int i, unsigned int n)
+    {
+      auto c = i - 1;
+      while (c + 1 < n)
+      {
+        const auto kBinomial = Binomial(c + 1, i);
+        if (kBinomial == 0 || kBinomial > rank)
+          break;
+        ++c;
+      }
+      rank -= Binomial(c, i);
+      return c;
+    }
+
+    /// Combination Unrank - k-combination of the given rank in colexicographic order.
+    ///
+    /// @param rank the rank of the combination.
+    /// @param k number of elements of the combination.
+    ///
+    /// @complexity O(n * k).
+    ///
+    /// @return the combination, bit i for element i.
+    inline std::uint64_t CombinationUnrank(unsigned long long rank, unsigned int k)
+    {
+      std::uint64_t mask = 0;
+      for (auto i = k; i > 0; --i)
+        mask |= 1ull << CombinationUnrankPosition(rank, i, 64);
+      return mask;
+    }
+
+    /// @class KCombinations
+    ///
+    /// Lazy enumeration of the C(n, k) combinations of k elements among n in colexicographic order.
+    /// Combinations are n bits masks: Gosper's hack computes the next one from a 64 bits word in O(1),
+    /// masks of more than 64 elements are stored as several words and moved to the next combination by
+    /// moving the lowest run of ones the same way.
+    ///
+    /// for (KCombinations combinations(n, k); combinations.IsValid(); combinations.Next())
+    ///   Use(combinations.Mask()); // or Words() when n > 64
+    ///
+    /// @advantages
+    /// - O(1) per combination (amortized when n > 64), no allocation once constructed.
+    /// - Combinations can be split across threads by starting each one at a given rank.
+    class KCombinations
+    {
+    public:
+      /// @param n number of elements.
+      /// @param k number of elements of each combination.
+      /// @param rank rank of the first combination to be visited (cf. CombinationUnrank).
+      KCombinations(unsigned int n, unsigned int k, unsigned long long rank = 0) :
+        n(n), k(k), words((n + 63) / 64 + (n == 0 ? 1 : 0), 0), valid(k <= n)
+      {
+        const auto kCount = Binomial(n, k);
+        if (!this->valid || (kCount != 0 && rank >= kCount))
+        {
+          this->valid = false;
+          return;
+        }
+
+        // Unrank the first combination
+        for (auto i = k; i > 0; --i)
+        {
+          const auto kPosition = CombinationUnrankPosition(rank, i, n);
+          this->words[kPosition / 64] |= 1ull << (kPosition % 64);
+        }
+      }
+
+      /// Next - Move to the next combination.
+      ///
+      /// @complexity O(1) using Gosper's hack (n <= 64), O(n / 64) amortized otherwise.
+      ///
+      /// @return false once all the combinations have been visited, true otherwise.
+      bool Next()
+      {
+        if (!this->valid)
+          return false;
+        if (this->k == 0 || this->k == this->n)
+          return this->valid = false;
+
+        // Gosper's hack: move the lowest run of ones, the run highest bit going one position up
+        if (this->n <= 64)
+        {
+          const auto kMask = this->words[0];
+          const auto kLowest = kMask & (~kMask + 1);
+          const auto kRipple = kMask + kLowest;
+          const auto kNext = (((kRipple ^ kMask) >> 2) / kLowest) | kRipple;
+          if (kRipple == 0 || (this->n < 64 && (kNext >> this->n) != 0))
+            return this->valid = false;
+          this->words[0] = kNext;
+          return true;
+        }
+
+        // Lowest run of ones [low, high[
+        std::size_t word = 0;
+        while (this->words[word] == 0)
+          ++word;
+        const auto kLow = word * 64 + LowestBitIndex(this->words[word]);
+        auto high = kLow;
+        while (high < this->n && this->Test(high))
+          ++high;
+        if (high >= this->n)
+          return this->valid = false;
+
+        // Run highest bit one position up, the others down to the lowest positions
+        for (auto i = kLow; i < high; ++i)
+          this->words[i / 64] &= ~(1ull << (i % 64));
+        this->words[high / 64] |= 1ull << (high % 64);
+        for (std::size_t i = 0; i + 1 < high - kLow; ++i)
+          this->words[i / 64] |= 1ull << (i % 64);
+        return true;
+      }
+
+      /// @return true while the current combination is a valid one.
+      bool IsValid() const { return this->valid; }
+
+      /// @return the current combination (n <= 64).
+      std::uint64_t Mask() const { return this->words[0]; }
+
+      /// @return the current combination as 64 bits words, bit i of the combination being the bit i % 64
+      /// of the word i / 64.
+      const std::vector<std::uint64_t>& Words() const { return this->words; }
+
+      /// @return whether the element i belongs to the current combination.
+      bool Test(std::size_t i) const { return ((this->words[i / 64] >> (i % 64)) & 1) != 0; }
+
+    private:
+      unsigned int n;                    // Number of elements
+      unsigned int k;                    // Number of elements of each combination
+      std::vector<std::uint64_t> words;  // Current combination
+      bool valid;                        // Whether the current combination is valid
+    };
   }
 }
 
@@ -0,0 +1,118 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_GENERATOR_HXX
+#define MODULE_COMBINATORY_GENERATOR_HXX
+
+// Coroutine generators are only available using a C++20 compiler
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#if defined(__has_include)
+#if __has_include(<coroutine>)
+#define HUC_COMBINATORY_COROUTINES
+#endif
+#endif
+#endif
+
+#ifdef HUC_COMBINATORY_COROUTINES
+
+// STD includes
+#include <coroutine>
+#include <iterator>
+#include <utility>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// @class Generator
+    ///
+    /// Minimal coroutine generator: a lazy input range over the values yielded by a coroutine, each value
+    /// being produced on increment only (callers may stop the iteration at any time).
+    ///
+    /// @tparam T type of the values yielded.
+    template <typename T>
+    class Generator
+    {
+    public:
+      struct promise_type
+      {
+        Generator get_return_object()
+        { return Generator(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& yielded) noexcept
+        {
+          // The yielded value lives within the coroutine frame until it is resumed
+          this->value = &yielded;
+          return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { throw; }
+
+        const T* value = nullptr;
+      };
+
+      class Iterator
+      {
+      public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        explicit Iterator(std::coroutine_handle<promise_type> handle = nullptr) : handle(handle) {}
+
+        const T& operator*() const { return *this->handle.promise().value; }
+        const T* operator->() const { return this->handle.promise().value; }
+        Iterator& operator++()
+        {
+          this->handle.resume();
+          return *this;
+        }
+        bool operator==(std::default_sentinel_t) const { return !this->handle || this->handle.done(); }
+
+      private:
+        std::coroutine_handle<promise_type> handle;
+      };
+
+      Generator(Generator&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+      ~Generator() { if (this->handle) this->handle.destroy(); }
+
+      Iterator begin()
+      {
+        if (this->handle)
+          this->handle.resume();
+        return Iterator(this->handle);
+      }
+      std::default_sentinel_t end() const { return std::default_sentinel; }
+
+    private:
+      explicit Generator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+      Generator(const Generator&) = delete;            // Not Implemented
+      Generator& operator=(const Generator&) = delete; // Not Implemented
+
+      std::coroutine_handle<promise_type> handle;
+    };
+  }
+}
+
+#endif // HUC_COMBINATORY_COROUTINES
+
+#endif // MODULE_COMBINATORY_GENERATOR_HXX
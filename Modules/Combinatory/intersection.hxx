@@ -20,48 +20,428 @@
 #ifndef MODULE_COMBINATORY_INTERSECTION_HXX
 #define MODULE_COMBINATORY_INTERSECTION_HXX
 
+#include <DataStructures/bloom_filter.hxx>
+
 // STD includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <set>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace huc
 {
   namespace combinatory
   {
-    /// Intersection - Return Intersection of the two sequences.
+    /// Intersection Filter - Compare all pairs of elements of two blocks of sorted keys.
     ///
-    /// @remark Retrieve the intersection of two sequences keeping dupplicate keys distinct.
+    /// @remark the SSE2 versions are used on contiguous 32 bits integers sequences, as inverted index
+    /// posting lists; other types are merged element by element.
     ///
+    /// @tparam T type of the elements.
+    template <typename T>
+    struct IntersectionFilter
+    {
+      static const bool kEnabled = false;
+      static const int kBlockSize = 4;
+
+      /// @return whether the kBlockSize + 1 first keys are all distinct.
+      static bool Unique(const T*) { return false; }
+
+      /// @return the mask of the keys of the first block (bit i for key i) found within the second one.
+      static int Matches(const T*, const T*) { return 0; }
+    };
+
+#if defined(__SSE2__)
+    /// SIMD Intersection Filter
+    template <typename T>
+    struct SimdIntersectionFilter
+    {
+      static const bool kEnabled = true;
+      static const int kBlockSize = 4;
+
+      static bool Unique(const T* data)
+      {
+        const auto kKeys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const auto kNextKeys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 1));
+        return _mm_movemask_epi8(_mm_cmpeq_epi32(kKeys, kNextKeys)) == 0;
+      }
+
+      static int Matches(const T* first, const T* second)
+      {
+        // Compare the first block with the four rotations of the second one
+        const auto kFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const auto kSecond = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second));
+        const auto kMatches =
+          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(kFirst, kSecond),
+                                    _mm_cmpeq_epi32(kFirst, _mm_shuffle_epi32(kSecond, 0x39))),
+                       _mm_or_si128(_mm_cmpeq_epi32(kFirst, _mm_shuffle_epi32(kSecond, 0x4E)),
+                                    _mm_cmpeq_epi32(kFirst, _mm_shuffle_epi32(kSecond, 0x93))));
+        return _mm_movemask_ps(_mm_castsi128_ps(kMatches));
+      }
+    };
+
+    template <> struct IntersectionFilter<int> : SimdIntersectionFilter<int> {};
+    template <> struct IntersectionFilter<unsigned int> : SimdIntersectionFilter<unsigned int> {};
+#endif
+
+    /// Intersection Merge - Intersection of two sorted sequences by merging them.
+    ///
+    /// @tparam Container type of the returned intersection.
     /// @tparam IT type using to go through the collection.
     ///
     /// @param beginFirst,endFirst,beginSecond,endSecond - iterators to the initial and final positions of
-    /// the sequences. The range used is [first,last), which contains all the elements between
+    /// the sorted sequences. The range used is [first,last), which contains all the elements between
     /// first and last, including the element pointed by first but not the element pointed by last.
     ///
-    /// @return a vector containing the intersection of both sequences.
+    /// @complexity O(n + m), blocks of keys are compared at once using IntersectionFilter on contiguous
+    /// sequences.
+    ///
+    /// @warning the algorithm does not check the validity on data order.
+    ///
+    /// @return the sorted intersection of both sequences, dupplicate keys kept distinct.
     template <typename Container, typename IT>
-    Container Intersection(const IT& beginFirst, const IT& endFirst,
-                           const IT& beginSecond, const IT& endSecond)
+    Container IntersectionMerge(const IT& beginFirst, const IT& endFirst,
+                                const IT& beginSecond, const IT& endSecond)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef IntersectionFilter<Value> Filter;
+      const bool kIsContiguous = std::is_pointer<IT>::value ||
+                                 std::is_same<IT, typename std::vector<Value>::iterator>::value ||
+                                 std::is_same<IT, typename std::vector<Value>::const_iterator>::value;
+
+      Container intersection;
+      intersection.reserve(std::min(std::distance(beginFirst, endFirst),
+                                    std::distance(beginSecond, endSecond)));
+
+      auto first = beginFirst;
+      auto second = beginSecond;
+      auto lMerge = [&]()
+      {
+        if (*first < *second)
+          ++first;
+        else if (*second < *first)
+          ++second;
+        else
+        {
+          intersection.push_back(*second);
+          ++first;
+          ++second;
+        }
+      };
+
+      // Blocks compared at once as long as their keys are unique within each sequence (the previous
+      // and next keys included): a match then consumes the single occurence of the key on both sides.
+      if (Filter::kEnabled && kIsContiguous)
+        while (std::distance(first, endFirst) > Filter::kBlockSize &&
+               std::distance(second, endSecond) > Filter::kBlockSize)
+        {
+          const Value* kFirstKeys = &*first;
+          const Value* kSecondKeys = &*second;
+          if ((first != beginFirst && !(kFirstKeys[-1] < kFirstKeys[0])) ||
+              (second != beginSecond && !(kSecondKeys[-1] < kSecondKeys[0])) ||
+              !Filter::Unique(kFirstKeys) || !Filter::Unique(kSecondKeys))
+          {
+            lMerge();
+            continue;
+          }
+
+          static const int kLowestBit[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+          for (auto matches = Filter::Matches(kFirstKeys, kSecondKeys); matches != 0; matches &= matches - 1)
+            intersection.push_back(kFirstKeys[kLowestBit[matches]]);
+
+          // Move the block(s) whose last key is the lowest
+          const auto& kFirstLast = kFirstKeys[Filter::kBlockSize - 1];
+          const auto& kSecondLast = kSecondKeys[Filter::kBlockSize - 1];
+          if (!(kSecondLast < kFirstLast))
+            std::advance(first, Filter::kBlockSize);
+          if (!(kFirstLast < kSecondLast))
+            std::advance(second, Filter::kBlockSize);
+        }
+
+      while (first != endFirst && second != endSecond)
+        lMerge();
+
+      return intersection;
+    }
+
+    /// Galloping Lower Bound - First position of the sorted range whose key is not lower than the key,
+    /// found by an exponential search from the beginning of the range.
+    ///
+    /// @tparam IT type using to go through the collection (random-access for the complexity to hold).
+    /// @tparam T type of the key.
+    ///
+    /// @complexity O(log(d)) where d is the distance between first and the position found.
+    ///
+    /// @return iterator to the first key not lower than the key, last if none.
+    template <typename IT, typename T>
+    IT GallopingLowerBound(const IT& first, const IT& last, const T& key)
+    {
+      // Double the bound until the key is reached: the key lies within ]bound / 2, bound]
+      const auto kSize = std::distance(first, last);
+      typename std::iterator_traits<IT>::difference_type bound = 1;
+      while (bound < kSize && *std::next(first, bound) < key)
+        bound *= 2;
+
+      return std::lower_bound(std::next(first, bound / 2),
+                              (bound < kSize) ? std::next(first, bound + 1) : last, key);
+    }
+
+    /// Intersection Galloping - Intersection of two sorted sequences of very different sizes: each
+    /// element of the smaller one is searched within the larger one by an exponential search starting
+    /// from the position of the previous match (cf. GallopingLowerBound).
+    ///
+    /// @tparam Container type of the returned intersection.
+    /// @tparam IT type using to go through the collection (random-access for the complexity to hold).
+    ///
+    /// @param beginFirst,endFirst,beginSecond,endSecond - iterators to the initial and final positions of
+    /// the sorted sequences. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @complexity O(n * log(m / n)) where n is the size of the smaller sequence.
+    ///
+    /// @warning the algorithm does not check the validity on data order.
+    ///
+    /// @return the sorted intersection of both sequences, dupplicate keys kept distinct.
+    template <typename Container, typename IT>
+    Container IntersectionGalloping(const IT& beginFirst, const IT& endFirst,
+                                    const IT& beginSecond, const IT& endSecond)
     {
+      // Take the smallest sequence for the searched keys
+      const auto kFirstSize = std::distance(beginFirst, endFirst);
+      const auto kSecondSize = std::distance(beginSecond, endSecond);
+      const bool kIsFirstSmaller = (kFirstSize <= kSecondSize);
+      const auto kSmallEndIt = (kIsFirstSmaller) ? endFirst : endSecond;
+      const auto kLargeEndIt = (kIsFirstSmaller) ? endSecond : endFirst;
+
+      Container intersection;
+      intersection.reserve((kIsFirstSmaller) ? kFirstSize : kSecondSize);
+
+      auto low = (kIsFirstSmaller) ? beginSecond : beginFirst;
+      auto it = (kIsFirstSmaller) ? beginFirst : beginSecond;
+      for (; it != kSmallEndIt && low != kLargeEndIt; ++it)
+      {
+        low = GallopingLowerBound(low, kLargeEndIt, *it);
+
+        // Move the matched element out of the searched range
+        if (low != kLargeEndIt && !(*it < *low))
+        {
+          intersection.push_back(*low);
+          ++low;
+        }
+      }
+
+      return intersection;
+    }
+
+    /// Is Hashable - Whether the keys of type T can be counted within a HashCounter: std::hash<T> and
+    /// operator== are available and T is default constructible.
+    template <typename T>
+    struct IsHashable
+    {
+      template <typename U,
+                typename = decltype(std::hash<U>()(std::declval<const U&>())),
+                typename = decltype(std::declval<const U&>() == std::declval<const U&>())>
+      static std::true_type Test(int);
+      template <typename U>
+      static std::false_type Test(...);
+
+      static const bool value = decltype(Test<T>(0))::value && std::is_default_constructible<T>::value;
+    };
+
+    /// @class HashCounter
+    ///
+    /// Open addressing hash table counting the occurences of keys (linear probing, filled up to 2/3 at
+    /// most), indexed by the highest bits of a Fibonacci hashing of the keys.
+    ///
+    /// @tparam T type of the keys.
+    /// @tparam Hash functor type used to hash the keys.
+    template <typename T, typename Hash = std::hash<T>>
+    class HashCounter
+    {
+      struct Slot
+      {
+        Slot() : count(0), used(false) {}
+
+        T key;
+        std::uint32_t count;
+        bool used;
+      };
+
+    public:
+      /// @param size maximal number of keys to be counted.
+      /// @param shift number of highest bits of the hashing to be ignored (already used to partition the
+      /// keys, cf. HashPartition).
+      explicit HashCounter(std::size_t size, unsigned int shift = 0) : shift(shift), bits(1)
+      {
+        while ((static_cast<std::size_t>(1) << this->bits) < size + size / 2)
+          ++this->bits;
+        this->mask = (static_cast<std::size_t>(1) << this->bits) - 1;
+        this->table.resize(this->mask + 1);
+      }
+
+      /// Fibonacci hashing of a key, whose highest bits are the best distributed ones.
+      static std::uint64_t Mix(const T& key)
+      { return static_cast<std::uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ull; }
+
+      /// Add an occurence of the key.
+      void Add(const T& key)
+      {
+        auto& slot = this->Find(key);
+        slot.key = key;
+        slot.used = true;
+        ++slot.count;
+      }
+
+      /// Remove an occurence of the key.
+      ///
+      /// @return true if an occurence has been removed, false if none was left.
+      bool Remove(const T& key)
+      {
+        auto& slot = this->Find(key);
+        if (slot.count == 0)
+          return false;
+
+        --slot.count;
+        return true;
+      }
+
+    private:
+      Slot& Find(const T& key)
+      {
+        auto index = static_cast<std::size_t>((Mix(key) << this->shift) >> (64 - this->bits));
+        while (this->table[index].used && !(this->table[index].key == key))
+          index = (index + 1) & this->mask;
+        return this->table[index];
+      }
+
+      unsigned int shift;       // Highest bits of the hashing ignored
+      unsigned int bits;        // Number of bits indexing the table
+      std::size_t mask;         // Table size - 1
+      std::vector<Slot> table;  // Slots
+    };
+
+    /// Intersection Hash - Intersection of two sequences by counting the elements of the smaller one
+    /// within an open addressing hash table (cf. HashCounter).
+    ///
+    /// @remark For highly selective intersections most lookups miss: the prefilter option discards most of
+    /// them using a Bloom Filter of the smaller sequence, smaller than the table and probed by batches.
+    ///
+    /// @tparam Container type of the returned intersection.
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Hash functor type used to hash the elements.
+    ///
+    /// @param beginFirst,endFirst,beginSecond,endSecond - iterators to the initial and final positions of
+    /// the sequences. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param prefilter whether the elements of the larger sequence are filtered using a Bloom Filter
+    /// before being looked up.
+    ///
+    /// @complexity O(n + m) on average.
+    ///
+    /// @return the intersection of both sequences in the order of the larger one, dupplicate keys kept
+    /// distinct.
+    template <typename Container, typename IT,
+              typename Hash = std::hash<typename std::iterator_traits<IT>::value_type>>
+    Container IntersectionHash(const IT& beginFirst, const IT& endFirst,
+                               const IT& beginSecond, const IT& endSecond, bool prefilter = false)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+
       // Take the smallest sequence for initial count
       const auto kFirstSize = std::distance(beginFirst, endFirst);
       const auto kSecondSize = std::distance(beginSecond, endSecond);
       const bool kIsFirstSmaller = (kFirstSize <= kSecondSize);
+      const auto kCountSize = static_cast<std::size_t>((kIsFirstSmaller) ? kFirstSize : kSecondSize);
 
       // Create and set enough capacity for the intersection
+      Container intersection;
+      intersection.reserve(kCountSize);
+      if (kCountSize == 0)
+        return intersection;
+
+      // Count each element of the smaller sequence
+      HashCounter<Value, Hash> count(kCountSize);
+      const auto kCountEndIt = (kIsFirstSmaller) ? endFirst : endSecond;
+      for (auto it = (kIsFirstSmaller) ? beginFirst : beginSecond; it != kCountEndIt; ++it)
+        count.Add(*it);
+
+      // Push the element if counted and decrease its count
+      const auto kIntersectEndIt = (kIsFirstSmaller) ? endSecond : endFirst;
+      if (!prefilter)
+      {
+        for (auto it = (kIsFirstSmaller) ? beginSecond : beginFirst; it != kIntersectEndIt; ++it)
+          if (count.Remove(*it))
+            intersection.push_back(*it);
+        return intersection;
+      }
+
+      // Same using only the elements passing the Bloom Filter, by chunks
+      const std::size_t kChunkSize = 1024;
+      BloomFilter<Value, Hash> filter(kCountSize);
+      filter.Insert((kIsFirstSmaller) ? beginFirst : beginSecond, kCountEndIt);
+      std::vector<Value> candidates;
+      candidates.reserve(kChunkSize);
+      for (auto it = (kIsFirstSmaller) ? beginSecond : beginFirst; it != kIntersectEndIt; )
+      {
+        auto chunkEnd = it;
+        for (std::size_t i = 0; i < kChunkSize && chunkEnd != kIntersectEndIt; ++i)
+          ++chunkEnd;
+
+        candidates.clear();
+        filter.Filter(it, chunkEnd, std::back_inserter(candidates));
+        for (auto candidate = candidates.begin(); candidate != candidates.end(); ++candidate)
+          if (count.Remove(*candidate))
+            intersection.push_back(*candidate);
+        it = chunkEnd;
+      }
+
+      return intersection;
+    }
+
+    /// Intersection Ordered - Intersection of two sequences by counting the elements of the smaller one
+    /// within an ordered multiset: only requires operator< on the elements.
+    ///
+    /// @tparam Container type of the returned intersection.
+    /// @tparam IT type using to go through the collection.
+    ///
+    /// @param beginFirst,endFirst,beginSecond,endSecond - iterators to the initial and final positions of
+    /// the sequences. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @complexity O((n + m) * log(n)) where n is the size of the smaller sequence.
+    ///
+    /// @return the intersection in the order of the larger sequence, dupplicate keys kept distinct.
+    template <typename Container, typename IT>
+    Container IntersectionOrdered(const IT& beginFirst, const IT& endFirst,
+                                  const IT& beginSecond, const IT& endSecond)
+    {
+      // Take the smallest sequence for initial count
+      const auto kFirstSize = std::distance(beginFirst, endFirst);
+      const auto kSecondSize = std::distance(beginSecond, endSecond);
+      const bool kIsFirstSmaller = (kFirstSize <= kSecondSize);
+
       Container intersection;
       intersection.reserve((kIsFirstSmaller) ? kFirstSize : kSecondSize);
 
       // Count each element of the smaller array
-      std::multiset<typename std::iterator_traits<IT>::value_type> count;
       const auto kCountEndIt = (kIsFirstSmaller) ? endFirst : endSecond;
-      for (auto it = (kIsFirstSmaller) ? beginFirst : beginSecond; it != kCountEndIt; ++it)
-          count.insert(*it);
+      std::multiset<typename std::iterator_traits<IT>::value_type>
+        count((kIsFirstSmaller) ? beginFirst : beginSecond, kCountEndIt);
 
-      // Push the element if find into the multiset and delete its instance from the counter
-      auto kIntersectEndIt = (kIsFirstSmaller) ? endSecond : endFirst;
+      // Move element from count to intersection if found
+      const auto kIntersectEndIt = (kIsFirstSmaller) ? endSecond : endFirst;
       for (auto it = (kIsFirstSmaller) ? beginSecond : beginFirst; it != kIntersectEndIt; ++it)
       {
-        // Move element from count to intersection if found
         auto foundIt = count.find(*it);
         if (foundIt != count.end())
         {
@@ -72,6 +452,215 @@ namespace huc
 
       return intersection;
     }
+
+    /// Hash Partition - Multi-threaded radix partitioning of a sequence on the highest bits of the keys
+    /// hashing (cf. HashCounter::Mix).
+    ///
+    /// Each thread builds the histogram of its chunk, the histograms prefix sums giving to each thread
+    /// its own destination within each partition; the keys are then scattered without synchronization.
+    ///
+    /// @tparam IT type using to go through the collection (random-access).
+    /// @tparam Hash functor type used to hash the elements.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of the sequence.
+    /// @param bits number of highest bits of the hashing defining the partitions (1 at least).
+    /// @param threads number of threads to be used.
+    /// @param keys the partitioned keys.
+    /// @param offsets the partitions offsets within the keys (2^bits + 1 values).
+    template <typename IT, typename Hash>
+    void HashPartition(const IT& begin, const IT& end, unsigned int bits, unsigned int threads,
+                       std::vector<typename std::iterator_traits<IT>::value_type>& keys,
+                       std::vector<std::size_t>& offsets)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      const std::size_t kPartitions = static_cast<std::size_t>(1) << bits;
+      const auto kSize = static_cast<std::size_t>(std::distance(begin, end));
+      const std::size_t kChunkSize = (kSize + threads - 1) / threads;
+      auto lPartition = [bits](const Value& key)
+      { return static_cast<std::size_t>(HashCounter<Value, Hash>::Mix(key) >> (64 - bits)); };
+      auto lRun = [threads](const std::function<void(unsigned int)>& function)
+      {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; ++t)
+          workers.push_back(std::thread(function, t));
+        for (auto it = workers.begin(); it != workers.end(); ++it)
+          it->join();
+      };
+
+      // Histogram of each chunk
+      std::vector<std::vector<std::size_t>> positions(threads, std::vector<std::size_t>(kPartitions, 0));
+      lRun([&](unsigned int t)
+      {
+        const auto kLast = std::next(begin, std::min(kSize, (t + 1) * kChunkSize));
+        for (auto it = std::next(begin, std::min(kSize, t * kChunkSize)); it != kLast; ++it)
+          ++positions[t][lPartition(*it)];
+      });
+
+      // Destination of each chunk within each partition
+      offsets.assign(kPartitions + 1, 0);
+      std::size_t position = 0;
+      for (std::size_t p = 0; p < kPartitions; ++p)
+      {
+        offsets[p] = position;
+        for (unsigned int t = 0; t < threads; ++t)
+        {
+          const auto kCount = positions[t][p];
+          positions[t][p] = position;
+          position += kCount;
+        }
+      }
+      offsets[kPartitions] = position;
+
+      // Scatter the keys
+      keys.resize(kSize);
+      lRun([&](unsigned int t)
+      {
+        auto& destinations = positions[t];
+        const auto kLast = std::next(begin, std::min(kSize, (t + 1) * kChunkSize));
+        for (auto it = std::next(begin, std::min(kSize, t * kChunkSize)); it != kLast; ++it)
+          keys[destinations[lPartition(*it)]++] = *it;
+      });
+    }
+
+    /// Parallel Intersection Hash - Multi-threaded version of IntersectionHash using a radix-partitioned
+    /// hash join: both sequences are partitioned on the highest bits of their keys hashing (cf.
+    /// HashPartition) so that the counting table of each partition fits within the cache, then the
+    /// partitions are intersected independently by the threads.
+    ///
+    /// @tparam Container type of the returned intersection.
+    /// @tparam IT type using to go through the collection (random-access).
+    /// @tparam Hash functor type used to hash the elements.
+    ///
+    /// @param beginFirst,endFirst,beginSecond,endSecond - iterators to the initial and final positions of
+    /// the sequences. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param threads number of threads to be used (IntersectionHash is used for a single one or small
+    /// sequences).
+    ///
+    /// @complexity O((n + m) / threads) on average, O(n + m) extra memory for the partitions.
+    ///
+    /// @return the intersection of both sequences grouped by partition, each partition in the order of
+    /// the larger sequence, dupplicate keys kept distinct (same elements as IntersectionHash).
+    template <typename Container, typename IT,
+              typename Hash = std::hash<typename std::iterator_traits<IT>::value_type>>
+    Container ParallelIntersectionHash(const IT& beginFirst, const IT& endFirst,
+                                       const IT& beginSecond, const IT& endSecond,
+                                       unsigned int threads = std::thread::hardware_concurrency())
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      const std::size_t kMinChunkSize = 4096;
+      const std::size_t kPartitionSize = 1 << 14;  // Counted keys per partition, for the table to fit L2
+      const unsigned int kMaxBits = 14;
+
+      // Take the smallest sequence for initial count
+      const auto kFirstSize = static_cast<std::size_t>(std::distance(beginFirst, endFirst));
+      const auto kSecondSize = static_cast<std::size_t>(std::distance(beginSecond, endSecond));
+      const bool kIsFirstSmaller = (kFirstSize <= kSecondSize);
+      const auto kCountSize = (kIsFirstSmaller) ? kFirstSize : kSecondSize;
+      threads = static_cast<unsigned int>(std::min<std::size_t>(std::max(1u, threads),
+                                                                kCountSize / kMinChunkSize));
+      if (threads < 2)
+        return IntersectionHash<Container, IT, Hash>(beginFirst, endFirst, beginSecond, endSecond);
+
+      // Enough partitions for each thread to handle several of them and for them to be cache-sized
+      unsigned int bits = 1;
+      while (bits < kMaxBits && ((static_cast<std::size_t>(1) << bits) < 4 * threads ||
+                                 (kCountSize >> bits) > kPartitionSize))
+        ++bits;
+
+      std::vector<Value> countKeys, intersectKeys;
+      std::vector<std::size_t> countOffsets, intersectOffsets;
+      HashPartition<IT, Hash>((kIsFirstSmaller) ? beginFirst : beginSecond,
+                              (kIsFirstSmaller) ? endFirst : endSecond, bits, threads,
+                              countKeys, countOffsets);
+      HashPartition<IT, Hash>((kIsFirstSmaller) ? beginSecond : beginFirst,
+                              (kIsFirstSmaller) ? endSecond : endFirst, bits, threads,
+                              intersectKeys, intersectOffsets);
+
+      // Each thread intersects a contiguous block of partitions pairs
+      const std::size_t kPartitions = static_cast<std::size_t>(1) << bits;
+      std::vector<std::vector<Value>> results(threads);
+      std::vector<std::thread> workers;
+      for (unsigned int t = 0; t < threads; ++t)
+        workers.push_back(std::thread([&, t]()
+        {
+          for (auto p = t * kPartitions / threads; p < (t + 1) * kPartitions / threads; ++p)
+          {
+            HashCounter<Value, Hash> count(countOffsets[p + 1] - countOffsets[p], bits);
+            for (auto i = countOffsets[p]; i < countOffsets[p + 1]; ++i)
+              count.Add(countKeys[i]);
+            for (auto i = intersectOffsets[p]; i < intersectOffsets[p + 1]; ++i)
+              if (count.Remove(intersectKeys[i]))
+                results[t].push_back(intersectKeys[i]);
+          }
+        }));
+      for (auto it = workers.begin(); it != workers.end(); ++it)
+        it->join();
+
+      Container intersection;
+      intersection.reserve(kCountSize);
+      for (auto it = results.begin(); it != results.end(); ++it)
+        intersection.insert(intersection.end(), it->begin(), it->end());
+      return intersection;
+    }
+
+    /// Intersection of unsorted sequences: hash table if the elements are hashable, ordered multiset
+    /// otherwise (cf. IsHashable).
+    template <typename Container, typename IT>
+    Container IntersectionUnsorted(const IT& beginFirst, const IT& endFirst,
+                                   const IT& beginSecond, const IT& endSecond, bool prefilter,
+                                   std::true_type /*isHashable*/)
+    { return IntersectionHash<Container, IT>(beginFirst, endFirst, beginSecond, endSecond, prefilter); }
+    template <typename Container, typename IT>
+    Container IntersectionUnsorted(const IT& beginFirst, const IT& endFirst,
+                                   const IT& beginSecond, const IT& endSecond, bool /*prefilter*/,
+                                   std::false_type /*isHashable*/)
+    { return IntersectionOrdered<Container, IT>(beginFirst, endFirst, beginSecond, endSecond); }
+
+    /// Intersection - Return Intersection of the two sequences.
+    ///
+    /// @remark Retrieve the intersection of two sequences keeping dupplicate keys distinct.
+    /// @remark The strategy is selected on the sequences: sorted ones are merged (IntersectionMerge), or
+    /// searched by galloping when their sizes differ a lot (IntersectionGalloping); unsorted ones are
+    /// intersected using a hash table (IntersectionHash) when the elements are hashable, an ordered
+    /// multiset otherwise (IntersectionOrdered): operator< is the only requirement on the elements.
+    ///
+    /// @tparam Container type of the returned intersection.
+    /// @tparam IT type using to go through the collection.
+    ///
+    /// @param beginFirst,endFirst,beginSecond,endSecond - iterators to the initial and final positions of
+    /// the sequences. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param prefilter whether the hash table lookups are prefiltered using a Bloom Filter (unsorted
+    /// sequences only, cf. IntersectionHash): to be used on highly selective intersections.
+    ///
+    /// @complexity O(n + m) on average, O(n * log(m / n)) for sorted sequences of very different sizes.
+    ///
+    /// @return a vector containing the intersection of both sequences, sorted if both sequences are,
+    /// in the order of the larger one otherwise.
+    template <typename Container, typename IT>
+    Container Intersection(const IT& beginFirst, const IT& endFirst,
+                           const IT& beginSecond, const IT& endSecond, bool prefilter = false)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+
+      // Minimal size ratio for galloping to beat merging
+      const std::size_t kGallopingRatio = 32;
+      const bool kIsRandomAccess = std::is_same<typename std::iterator_traits<IT>::iterator_category,
+                                                std::random_access_iterator_tag>::value;
+
+      if (!std::is_sorted(beginFirst, endFirst) || !std::is_sorted(beginSecond, endSecond))
+        return IntersectionUnsorted<Container, IT>(beginFirst, endFirst, beginSecond, endSecond, prefilter,
+          std::integral_constant<bool, IsHashable<Value>::value>());
+
+      const auto kFirstSize = static_cast<std::size_t>(std::distance(beginFirst, endFirst));
+      const auto kSecondSize = static_cast<std::size_t>(std::distance(beginSecond, endSecond));
+      if (kIsRandomAccess && (kFirstSize * kGallopingRatio <= kSecondSize ||
+                              kSecondSize * kGallopingRatio <= kFirstSize))
+        return IntersectionGalloping<Container, IT>(beginFirst, endFirst, beginSecond, endSecond);
+
+      return IntersectionMerge<Container, IT>(beginFirst, endFirst, beginSecond, endSecond);
+    }
   }
 }
 
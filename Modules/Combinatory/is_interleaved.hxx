@@ -20,58 +20,306 @@
 #ifndef MODULE_COMBINATORY_IS_INTERLEAVED_HXX
 #define MODULE_COMBINATORY_IS_INTERLEAVED_HXX
 
+#include <Combinatory/combinations.hxx>
+#include <Combinatory/intersection.hxx>
+
 // STD includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <map>
+#include <type_traits>
+#include <vector>
 
 namespace huc
 {
   namespace combinatory
   {
+    /// Interleave Counter - Check whether the elements of a sequence are the ones of two others.
+    ///
+    /// @remark small integral types (char, short...) are counted within a direct-indexed array, using four
+    /// interleaved histograms for single bytes elements so that consecutive increments do not wait for
+    /// each other; other types are counted within an open addressing hash table (cf. HashCounter), or
+    /// within an ordered map if they are not hashable (cf. IsHashable).
+    ///
+    /// @tparam T type of the elements.
+    template <typename T, bool IsSmall = std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                         sizeof(T) <= 2>
+    struct InterleaveCounter
+    {
+      /// @return true if the full sequence holds the same elements as both others, false otherwise.
+      template <typename IT>
+      static bool SameElements(const IT& beginFirst, const IT& endFirst,
+                               const IT& beginSecond, const IT& endSecond,
+                               const IT& beginFull, const IT& endFull)
+      {
+        return SameElements(beginFirst, endFirst, beginSecond, endSecond, beginFull, endFull,
+                            std::integral_constant<bool, IsHashable<T>::value>());
+      }
+
+    private:
+      template <typename IT>
+      static bool SameElements(const IT& beginFirst, const IT& endFirst,
+                               const IT& beginSecond, const IT& endSecond,
+                               const IT& beginFull, const IT& endFull, std::true_type /*isHashable*/)
+      {
+        HashCounter<T> count(static_cast<std::size_t>(std::distance(beginFirst, endFirst) +
+                                                      std::distance(beginSecond, endSecond)));
+        for (auto it = beginFirst; it != endFirst; ++it)
+          count.Add(*it);
+        for (auto it = beginSecond; it != endSecond; ++it)
+          count.Add(*it);
+
+        // Sizes being equal, no missing occurence implies no extra one
+        for (auto it = beginFull; it != endFull; ++it)
+          if (!count.Remove(*it))
+            return false;
+
+        return true;
+      }
+
+      template <typename IT>
+      static bool SameElements(const IT& beginFirst, const IT& endFirst,
+                               const IT& beginSecond, const IT& endSecond,
+                               const IT& beginFull, const IT& endFull, std::false_type /*isHashable*/)
+      {
+        std::map<T, std::size_t> count;
+        for (auto it = beginFirst; it != endFirst; ++it)
+          ++count[*it];
+        for (auto it = beginSecond; it != endSecond; ++it)
+          ++count[*it];
+
+        // Sizes being equal, no missing occurence implies no extra one
+        for (auto it = beginFull; it != endFull; ++it)
+        {
+          auto countIt = count.find(*it);
+          if (countIt == count.end() || countIt->second == 0)
+            return false;
+          --countIt->second;
+        }
+
+        return true;
+      }
+    };
+
+    template <typename T>
+    struct InterleaveCounter<T, true>
+    {
+      template <typename IT>
+      static bool SameElements(const IT& beginFirst, const IT& endFirst,
+                               const IT& beginSecond, const IT& endSecond,
+                               const IT& beginFull, const IT& endFull)
+      {
+        typedef typename std::make_unsigned<T>::type Index;
+        const std::size_t kHistograms = (sizeof(T) == 1) ? 4 : 1;
+        const std::size_t kBins = static_cast<std::size_t>(1) << (8 * sizeof(T));
+        std::vector<std::ptrdiff_t> count(kHistograms * kBins, 0);
+
+        // Element k is counted within the histogram k % kHistograms
+        auto lCount = [&](const IT& begin, const IT& end, std::ptrdiff_t increment)
+        {
+          std::size_t histogram = 0;
+          for (auto it = begin; it != end; ++it, histogram = (histogram + kBins) % count.size())
+            count[histogram + static_cast<Index>(*it)] += increment;
+        };
+        lCount(beginFirst, endFirst, 1);
+        lCount(beginSecond, endSecond, 1);
+        lCount(beginFull, endFull, -1);
+
+        for (std::size_t bin = 0; bin < kBins; ++bin)
+        {
+          std::ptrdiff_t total = 0;
+          for (std::size_t histogram = 0; histogram < count.size(); histogram += kBins)
+            total += count[histogram + bin];
+          if (total != 0)
+            return false;
+        }
+
+        return true;
+      }
+    };
+
     /// IsInterleaved - Return whether or not if a sequence is the interleave of the two others.
     ///
+    /// @remark only the elements are compared, not their order: cf. IsOrderedInterleave to check whether
+    /// the order of both sequences is preserved within the full sequence.
+    ///
     /// @tparam IT type using to go through the collection.
     ///
     /// @param beginFirst,endFirst,beginSecond,endSecond,beginFull,endFull - iterators to the initial and
     /// final positions of the sequences. The range used is [first,last), which contains all the elements
     /// between first and last, including the element pointed by first but not the element pointed by last.
     ///
+    /// @complexity O(n) on average, elements being counted using InterleaveCounter.
+    ///
     /// @return true if the last sequence is the interleave of the two others, false otherwise.
     template <typename IT>
     bool IsInterleaved(const IT& beginFirst, const IT& endFirst,
                        const IT& beginSecond, const IT& endSecond,
                        const IT& beginFull, const IT& endFull)
     {
-      // Lambda that count each element occurence within the map "count"
-      std::map<typename std::iterator_traits<IT>::value_type, int> count;
-      auto lCountElement = [&count](typename std::iterator_traits<IT>::value_type(val))
-      {
-        auto countIt = count.find(val);
-        if (countIt != count.end())
-          ++countIt->second;
-        else
-          count.emplace(val, 1);
-      };
+      if (std::distance(beginFull, endFull) !=
+          std::distance(beginFirst, endFirst) + std::distance(beginSecond, endSecond))
+        return false;
+
+      return InterleaveCounter<typename std::iterator_traits<IT>::value_type>::SameElements
+        (beginFirst, endFirst, beginSecond, endSecond, beginFull, endFull);
+    }
 
-      // Count both sequences
-      std::for_each(beginFirst, endFirst, lCountElement);
-      std::for_each(beginSecond, endSecond, lCountElement);
+    /// IsOrderedInterleave - Return whether or not if a sequence is an interleave of the two others
+    /// preserving their order: the full sequence can be split into two subsequences equal to both
+    /// others.
+    ///
+    /// @remark A bit-parallel dynamic programming over the positions p of the full sequence: the state is
+    /// the bitset of the positions j such that the first p elements of the full sequence are an interleave
+    /// of the first p - j elements of the longer sequence (a) and the first j elements of the shorter one
+    /// (b). Next state is (state & A) | ((state & B) << 1) where A and B are the bitsets of the j such
+    /// that a[p - j] == c[p] and b[j] == c[p]. For sequences of at most kMaxSymbols distinct elements,
+    /// A and B are words of per element bitsets of a (reversed) and b, so that a state is computed in
+    /// O(m / 64) word operations; they are built from element comparisons on the bits set otherwise.
+    /// Only the words between the first and last bits set are processed, so that weakly ambiguous
+    /// sequences (e.g. streams of events) are checked in almost linear time.
+    ///
+    /// @tparam IT type using to go through the collection (random-access).
+    ///
+    /// @param beginFirst,endFirst,beginSecond,endSecond,beginFull,endFull - iterators to the initial and
+    /// final positions of the sequences. The range used is [first,last), which contains all the elements
+    /// between first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @complexity O((n + m) * m / 64) word operations and O(k * (n + m) / 64) memory for k <= 64 distinct
+    /// elements, m being the size of the shorter sequence; otherwise O((n + m) * W) element comparisons
+    /// and O(m / 64) memory, W being the maximal number of bits set within a state (m at most).
+    ///
+    /// @return true if the last sequence is an interleave of the two others preserving their order, false
+    /// otherwise.
+    template <typename IT>
+    bool IsOrderedInterleave(const IT& beginFirst, const IT& endFirst,
+                             const IT& beginSecond, const IT& endSecond,
+                             const IT& beginFull, const IT& endFull)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      const std::size_t kMaxSymbols = 64;
+
+      const auto kFirstSize = std::distance(beginFirst, endFirst);
+      const auto kSecondSize = std::distance(beginSecond, endSecond);
+      if (kFirstSize < 0 || kSecondSize < 0 || std::distance(beginFull, endFull) != kFirstSize + kSecondSize)
+        return false;
 
-      // Decrease the count of each element given the full sequence
-      for (auto it = beginFull; it != endFull; ++it)
+      // Bits are indexed by the shorter sequence (b)
+      const bool kIsFirstLonger = (kFirstSize >= kSecondSize);
+      const auto a = (kIsFirstLonger) ? beginFirst : beginSecond;
+      const auto b = (kIsFirstLonger) ? beginSecond : beginFirst;
+      const auto c = beginFull;
+      const auto n = static_cast<std::size_t>((kIsFirstLonger) ? kFirstSize : kSecondSize);
+      const auto m = static_cast<std::size_t>((kIsFirstLonger) ? kSecondSize : kFirstSize);
+      const std::size_t kWords = m / 64 + 1;
+
+      // Distinct elements of the full sequence, given up beyond kMaxSymbols
+      std::vector<Value> symbols;
+      std::vector<std::uint8_t> fullSymbols(n + m);
+      for (std::size_t p = 0; p < n + m && symbols.size() <= kMaxSymbols; ++p)
       {
-        auto countIt = count.find(*it);
-        if (countIt == count.end())
-          return false;
-        if (--countIt->second < 0)
-          return false;
+        const auto kSymbol = std::find(symbols.begin(), symbols.end(), c[p]);
+        fullSymbols[p] = static_cast<std::uint8_t>(kSymbol - symbols.begin());
+        if (kSymbol == symbols.end())
+          symbols.push_back(c[p]);
       }
+      const bool kUseBitsets = symbols.size() <= kMaxSymbols;
 
-      // Fail if hte count is not equal to 0
-      for (auto it = count.begin(); it != count.end(); ++it)
-        if (it->second != 0)
+      // Per element bitsets: bit j of b (bSymbols), bit kPadding + t of a reversed (aSymbols), padded so
+      // that the word of A starting at bit j = 64 * w is read at bit 64 * w + n - 1 - p + kPadding >= 0
+      const std::size_t kPadding = 64 * kWords;
+      const std::size_t kAWords = (kPadding + n) / 64 + 2;
+      std::vector<std::uint64_t> aSymbols, bSymbols;
+      if (kUseBitsets)
+      {
+        aSymbols.assign(symbols.size() * kAWords, 0);
+        bSymbols.assign(symbols.size() * kWords, 0);
+        for (std::size_t t = 0; t < n; ++t)
+        {
+          const auto kSymbol = static_cast<std::size_t>(
+            std::find(symbols.begin(), symbols.end(), a[n - 1 - t]) - symbols.begin());
+          if (kSymbol < symbols.size())
+            aSymbols[kSymbol * kAWords + (kPadding + t) / 64] |= 1ull << ((kPadding + t) % 64);
+        }
+        for (std::size_t j = 0; j < m; ++j)
+        {
+          const auto kSymbol = static_cast<std::size_t>(
+            std::find(symbols.begin(), symbols.end(), b[j]) - symbols.begin());
+          if (kSymbol < symbols.size())
+            bSymbols[kSymbol * kWords + j / 64] |= 1ull << (j % 64);
+        }
+      }
+
+      // Words w of A and B at position p, restricted to the bits of the state when built from comparisons
+      auto lMasks = [&](std::size_t p, std::size_t w, std::uint64_t state, std::uint64_t& maskA,
+                        std::uint64_t& maskB)
+      {
+        if (kUseBitsets)
+        {
+          const auto* kABits = &aSymbols[fullSymbols[p] * kAWords];
+          const auto kBit = 64 * w + n - 1 - p + kPadding;
+          const auto kShift = kBit % 64;
+          maskA = kABits[kBit / 64] >> kShift;
+          if (kShift != 0)
+            maskA |= kABits[kBit / 64 + 1] << (64 - kShift);
+          maskB = bSymbols[fullSymbols[p] * kWords + w];
+          return;
+        }
+
+        maskA = maskB = 0;
+        for (; state != 0; state &= state - 1)
+        {
+          const auto k = LowestBitIndex(state);
+          const auto j = 64 * w + k;
+          if (p - j < n && a[p - j] == c[p])
+            maskA |= 1ull << k;
+          if (j < m && b[j] == c[p])
+            maskB |= 1ull << k;
+        }
+      };
+
+      std::vector<std::uint64_t> previous(kWords, 0), current(kWords, 0);
+      previous[0] = 1;
+      std::size_t low = 0, high = 0;            // Words of the previous state holding bits set
+      std::size_t staleLow = 0, staleHigh = 0;  // Words of the current buffer to be cleared
+      for (std::size_t p = 0; p < n + m; ++p)
+      {
+        std::fill(current.begin() + staleLow, current.begin() + staleHigh + 1, 0);
+
+        std::uint64_t shiftIn = 0;
+        std::size_t first = kWords, last = 0;
+        for (std::size_t w = low; w < kWords && (w <= high || shiftIn != 0); ++w)
+        {
+          std::uint64_t maskA = 0, maskB = 0;
+          if (previous[w] != 0)
+            lMasks(p, w, previous[w], maskA, maskB);
+
+          // Stay on j taking a[p - j], move to j + 1 taking b[j]
+          const auto kFromB = previous[w] & maskB;
+          current[w] = (previous[w] & maskA) | (kFromB << 1) | shiftIn;
+          shiftIn = kFromB >> 63;
+
+          if (current[w] != 0)
+          {
+            first = std::min(first, w);
+            last = w;
+          }
+        }
+
+        // No interleave of the prefixes left
+        if (first == kWords)
           return false;
 
-      return true;
+        staleLow = low;
+        staleHigh = std::min(high + 1, kWords - 1);
+        low = first;
+        high = last;
+        std::swap(previous, current);
+      }
+
+      return ((previous[m / 64] >> (m % 64)) & 1) != 0;
     }
   }
 }
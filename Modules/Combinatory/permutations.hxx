@@ -20,8 +20,17 @@
 #ifndef MODULE_COMBINATORY_PERMUTATIONS_HXX
 #define MODULE_COMBINATORY_PERMUTATIONS_HXX
 
+#include <Combinatory/generator.hxx>
+
 // STD includes
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <list>
+#include <thread>
+#include <vector>
 
 namespace huc
 {
@@ -32,6 +41,7 @@ namespace huc
     /// @remark a vector is not recommended as type for the Output_Container to avoid stack overflow as well
     /// as extra complexity due to frequent resizing (use instead structure such as list or a another with
     /// your own allocator).
+    /// @remark use HeapPermutations to visit the permutations in place without storing them.
     ///
     /// @tparam IT type using to go through the collection.
     ///
@@ -74,6 +84,455 @@ namespace huc
 
       return permutations;
     }
+
+    /// @class PermutationView
+    ///
+    /// Non-owning view on a sequence permuted in place, as returned by the lazy permutation generators.
+    ///
+    /// @tparam IT type using to go through the collection.
+    template <typename IT>
+    class PermutationView
+    {
+    public:
+      PermutationView(const IT& first, const IT& last) : first(first), last(last) {}
+
+      IT begin() const { return this->first; }
+      IT end() const { return this->last; }
+      std::size_t size() const { return static_cast<std::size_t>(std::distance(this->first, this->last)); }
+      typename std::iterator_traits<IT>::reference operator[](std::size_t i) const
+      { return *(this->first + i); }
+
+    private:
+      IT first;
+      IT last;
+    };
+
+    /// @class PermutationIterator
+    ///
+    /// Input iterator over the permutations of a lazy generator (cf. HeapPermutations), all of them
+    /// sharing the same sequence permuted in place.
+    ///
+    /// @tparam Permutations type of the generator, providing Next and Current.
+    template <typename Permutations>
+    class PermutationIterator
+    {
+    public:
+      typedef std::input_iterator_tag iterator_category;
+      typedef typename Permutations::View value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const value_type* pointer;
+      typedef value_type reference;
+
+      PermutationIterator(Permutations* permutations, bool done) : permutations(permutations), done(done) {}
+
+      value_type operator*() const { return this->permutations->Current(); }
+      PermutationIterator& operator++()
+      {
+        this->done = !this->permutations->Next();
+        return *this;
+      }
+      bool operator==(const PermutationIterator& other) const { return this->done == other.done; }
+      bool operator!=(const PermutationIterator& other) const { return this->done != other.done; }
+
+    private:
+      Permutations* permutations;
+      bool done;
+    };
+
+    /// @class HeapPermutations
+    ///
+    /// Lazy generation of the n! permutations of a sequence using Heap's algorithm: each permutation is
+    /// obtained from the previous one by a single swap, the sequence being permuted in place.
+    ///
+    /// Permutations are visited using Next (as std::next_permutation) or by iterating over the object
+    /// itself; the iteration can be stopped at any time.
+    ///
+    /// @advantages
+    /// - O(1) amortized per permutation, no allocation once constructed (n counters).
+    /// - Works with any elements, no ordering needed.
+    ///
+    /// @drawbacks
+    /// - Permutations are not visited in lexicographic order.
+    /// - The sequence is modified: it ends up in the last permutation visited.
+    ///
+    /// @tparam IT random-access iterator type using to go through the collection.
+    template <typename IT>
+    class HeapPermutations
+    {
+    public:
+      typedef PermutationView<IT> View;
+      typedef PermutationIterator<HeapPermutations> Iterator;
+
+      /// @param begin,end - iterators to the initial and final positions of
+      /// the sequence, the sequence itself being the first permutation. The range used is [first,last),
+      /// which contains all the elements between first and last, including the element pointed by first
+      /// but not the element pointed by last.
+      HeapPermutations(const IT& begin, const IT& end) :
+        first(begin), last(end),
+        size(static_cast<std::size_t>(std::max<std::ptrdiff_t>(0, std::distance(begin, end)))),
+        counters(size, 0), level(1) {}
+
+      /// Next - Permute the sequence into the next permutation.
+      ///
+      /// @complexity O(1) amortized.
+      ///
+      /// @return false once all the permutations have been visited, true otherwise.
+      bool Next()
+      {
+        while (this->level < this->size)
+        {
+          auto& counter = this->counters[this->level];
+          if (counter < this->level)
+          {
+            std::iter_swap(this->first + ((this->level % 2 == 0) ? 0 : counter), this->first + this->level);
+            ++counter;
+            this->level = 1;
+            return true;
+          }
+
+          counter = 0;
+          ++this->level;
+        }
+        return false;
+      }
+
+      /// @return a view on the current permutation.
+      View Current() const { return View(this->first, this->last); }
+
+      Iterator begin() { return Iterator(this, this->size == 0); }
+      Iterator end() { return Iterator(this, true); }
+
+    private:
+      IT first;                          // Sequence permuted in place
+      IT last;
+      std::size_t size;                  // Number of elements
+      std::vector<std::size_t> counters; // Heap's algorithm loop counters (stack state)
+      std::size_t level;                 // Current level of the iterative algorithm
+    };
+
+    /// @class MultisetPermutations
+    ///
+    /// Lazy generation of the distinct permutations of a sequence which may contain equal elements, in
+    /// lexicographic order, using Knuth's Algorithm L: each distinct arrangement is visited exactly once,
+    /// the sequence being permuted in place.
+    ///
+    /// Permutations are visited using Next or by iterating over the object itself; the iteration can be
+    /// stopped at any time.
+    ///
+    /// @advantages
+    /// - MultisetPermutationsCount(n) permutations visited instead of n! (cf. HeapPermutations).
+    /// - O(1) amortized per permutation, no allocation.
+    ///
+    /// @drawbacks
+    /// - The sequence is sorted on construction, elements must be comparable.
+    ///
+    /// @tparam IT random-access iterator type using to go through the collection.
+    /// @tparam Compare strict ordering functor type.
+    template <typename IT, typename Compare = std::less<typename std::iterator_traits<IT>::value_type>>
+    class MultisetPermutations
+    {
+    public:
+      typedef PermutationView<IT> View;
+      typedef PermutationIterator<MultisetPermutations> Iterator;
+
+      /// @param begin,end - iterators to the initial and final positions of
+      /// the sequence, sorted to be the first permutation. The range used is [first,last), which contains
+      /// all the elements between first and last, including the element pointed by first but not the
+      /// element pointed by last.
+      MultisetPermutations(const IT& begin, const IT& end) : first(begin), last(end)
+      {
+        if (begin < end)
+          std::sort(begin, end, Compare());
+      }
+
+      /// Next - Permute the sequence into the next distinct permutation in lexicographic order.
+      ///
+      /// @complexity O(1) amortized.
+      ///
+      /// @return false once all the permutations have been visited (the sequence is then sorted again),
+      /// true otherwise.
+      bool Next()
+      {
+        if (this->last - this->first < 2)
+          return false;
+
+        // L2 - Find the last position j such that a[j] < a[j+1]
+        auto j = this->last - 2;
+        while (!Compare()(*j, *(j + 1)))
+        {
+          if (j == this->first)
+          {
+            std::reverse(this->first, this->last);
+            return false;
+          }
+          --j;
+        }
+
+        // L3 - Swap a[j] with the last element greater than it
+        auto l = this->last - 1;
+        while (!Compare()(*j, *l))
+          --l;
+        std::iter_swap(j, l);
+
+        // L4 - Reverse the suffix to get its smallest arrangement
+        std::reverse(j + 1, this->last);
+        return true;
+      }
+
+      /// @return a view on the current permutation.
+      View Current() const { return View(this->first, this->last); }
+
+      Iterator begin() { return Iterator(this, !(this->first < this->last)); }
+      Iterator end() { return Iterator(this, true); }
+
+    private:
+      IT first;  // Sequence permuted in place
+      IT last;
+    };
+
+    /// Multiset Permutations Count - Number of distinct permutations of a sequence: the multinomial
+    /// coefficient n! / (m1! * m2! * ... * mk!) where mi are the multiplicities of the distinct elements.
+    ///
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Compare strict ordering functor type.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of
+    /// the sequence. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @complexity O(n * log(n)).
+    ///
+    /// @return the number of distinct permutations, 0 if it cannot be represented using 64 bits.
+    template <typename IT, typename Compare = std::less<typename std::iterator_traits<IT>::value_type>>
+    unsigned long long MultisetPermutationsCount(const IT& begin, const IT& end)
+    {
+      std::vector<typename std::iterator_traits<IT>::value_type> sorted(begin, end);
+      std::sort(sorted.begin(), sorted.end(), Compare());
+
+      auto lGcd = [](unsigned long long a, unsigned long long b)
+      {
+        while (b != 0)
+        {
+          const auto kRemainder = a % b;
+          a = b;
+          b = kRemainder;
+        }
+        return a;
+      };
+
+      // Product of the binomial coefficients C(placed + m, m) computed without intermediate overflow
+      unsigned long long count = 1;
+      unsigned long long placed = 0;
+      for (auto it = sorted.begin(); it != sorted.end(); )
+      {
+        const auto kGroupEnd = std::upper_bound(it, sorted.end(), *it, Compare());
+        const auto kMultiplicity = static_cast<unsigned long long>(std::distance(it, kGroupEnd));
+        for (unsigned long long i = 1; i <= kMultiplicity; ++i)
+        {
+          // count * (placed + i) / i is exact: divide by the common factors first
+          auto numerator = placed + i;
+          auto denominator = i;
+          const auto kCountGcd = lGcd(count, denominator);
+          count /= kCountGcd;
+          denominator /= kCountGcd;
+          numerator /= denominator;
+          if (count > std::numeric_limits<unsigned long long>::max() / numerator)
+            return 0;
+          count *= numerator;
+        }
+        placed += kMultiplicity;
+        it = kGroupEnd;
+      }
+      return count;
+    }
+
+    /// Factorial - n! computed using 64 bits.
+    ///
+    /// @param n the number of elements.
+    ///
+    /// @return n!, 0 if it cannot be represented (n > 20).
+    inline unsigned long long Factorial(unsigned int n)
+    {
+      if (n > 20)
+        return 0;
+
+      unsigned long long factorial = 1;
+      for (unsigned int i = 2; i <= n; ++i)
+        factorial *= i;
+      return factorial;
+    }
+
+    /// Permutation Rank - Rank of the sequence among the permutations of its elements in lexicographic
+    /// order (Lehmer code read in the factorial number system).
+    ///
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Compare functor type.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of
+    /// the sequence of distinct elements. The range used is [first,last), which contains all the elements
+    /// between first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @complexity O(n^2).
+    ///
+    /// @return the zero-based rank of the permutation (0 for the sorted sequence).
+    template <typename IT, typename Compare = std::less<typename std::iterator_traits<IT>::value_type>>
+    unsigned long long PermutationRank(const IT& begin, const IT& end)
+    {
+      const auto kSize = std::distance(begin, end);
+      unsigned long long rank = 0;
+      for (auto it = begin; it != end; ++it)
+      {
+        // Lehmer digit: number of following elements lower than the current one
+        unsigned long long digit = 0;
+        for (auto next = it + 1; next != end; ++next)
+          digit += Compare()(*next, *it) ? 1 : 0;
+        rank += digit * Factorial(static_cast<unsigned int>(kSize - 1 - std::distance(begin, it)));
+      }
+      return rank;
+    }
+
+    /// Permutation Unrank - Permute the sequence, considered as the first permutation (rank 0), into the
+    /// permutation of the given rank in lexicographic order of the elements positions.
+    ///
+    /// @details On a sorted sequence of distinct elements, the result is the permutation whose
+    /// PermutationRank is rank.
+    ///
+    /// @tparam IT type using to go through the collection.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of
+    /// the sequence. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param rank the zero-based rank of the permutation.
+    ///
+    /// @complexity O(n^2).
+    ///
+    /// @return false if the rank is out of range (the sequence is then not modified), true otherwise.
+    template <typename IT>
+    bool PermutationUnrank(const IT& begin, const IT& end, unsigned long long rank)
+    {
+      const auto kSize = static_cast<unsigned int>(std::max<std::ptrdiff_t>(0, std::distance(begin, end)));
+      const auto kCount = Factorial(kSize);
+      if (kSize == 0 || (kCount != 0 && rank >= kCount))
+        return false;
+
+      // Bring the element selected by each Lehmer digit in front of the remaining ones
+      for (unsigned int i = 0; i + 1 < kSize; ++i)
+      {
+        const auto kFactorial = Factorial(kSize - 1 - i);
+        if (kFactorial == 0)
+          continue;
+
+        const auto kDigit = static_cast<std::ptrdiff_t>(rank / kFactorial);
+        rank %= kFactorial;
+        std::rotate(begin + i, begin + i + kDigit, begin + i + kDigit + 1);
+      }
+      return true;
+    }
+
+    /// Parallel For Each Permutation - Call a function on each permutation of a sequence using threads.
+    ///
+    /// @details The n! ranks of the permutations (cf. PermutationUnrank) are split into one chunk per
+    /// thread: each thread copies the sequence, unranks its first permutation, then visits the following
+    /// ones in place in lexicographic order of the elements positions.
+    ///
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Function functor type called by several threads at once on a view of each permutation
+    /// (const PermutationView<std::vector<Value>::const_iterator>&).
+    ///
+    /// @param begin,end - iterators to the initial and final positions of
+    /// the sequence, not modified. The range used is [first,last), which contains all the elements
+    /// between first and last, including the element pointed by first but not the element pointed by last.
+    /// @param function the function called on each permutation.
+    /// @param threads number of threads to be used (hardware concurrency by default).
+    ///
+    /// @return false if the sequence is empty or contains more than 20 elements, true otherwise.
+    template <typename IT, typename Function>
+    bool ParallelForEachPermutation(const IT& begin, const IT& end, Function function,
+                                    unsigned int threads = std::thread::hardware_concurrency())
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef PermutationView<typename std::vector<Value>::const_iterator> View;
+
+      const auto kSize = static_cast<unsigned int>(std::max<std::ptrdiff_t>(0, std::distance(begin, end)));
+      const auto kCount = Factorial(kSize);
+      if (kSize == 0 || kCount == 0)
+        return false;
+
+      threads = static_cast<unsigned int>(std::min<unsigned long long>(std::max(1u, threads), kCount));
+      const auto kChunkSize = (kCount + threads - 1) / threads;
+      auto lVisit = [&](unsigned long long first, unsigned long long last)
+      {
+        // Elements and their original positions are permuted together
+        std::vector<Value> values(begin, end);
+        std::vector<unsigned int> positions(kSize);
+        for (unsigned int i = 0; i < kSize; ++i)
+          positions[i] = i;
+        PermutationUnrank(values.begin(), values.end(), first);
+        PermutationUnrank(positions.begin(), positions.end(), first);
+
+        const View kView(values.cbegin(), values.cend());
+        for (auto rank = first; rank < last; ++rank)
+        {
+          function(kView);
+          if (rank + 1 == last)
+            break;
+
+          // Next permutation of the positions, the same swaps being applied to the elements
+          auto i = kSize - 1;
+          while (positions[i - 1] > positions[i])
+            --i;
+          auto j = kSize - 1;
+          while (positions[j] < positions[i - 1])
+            --j;
+          std::swap(positions[i - 1], positions[j]);
+          std::swap(values[i - 1], values[j]);
+          std::reverse(positions.begin() + i, positions.end());
+          std::reverse(values.begin() + i, values.end());
+        }
+      };
+
+      std::vector<std::thread> workers;
+      for (unsigned int t = 1; t < threads; ++t)
+        if (t * kChunkSize < kCount)
+          workers.push_back(std::thread(lVisit, t * kChunkSize, std::min(kCount, (t + 1) * kChunkSize)));
+      lVisit(0, std::min(kCount, kChunkSize));
+      for (auto it = workers.begin(); it != workers.end(); ++it)
+        it->join();
+
+      return true;
+    }
+
+#ifdef HUC_COMBINATORY_COROUTINES
+    /// Lazy Permutations - C++20 coroutine facade over HeapPermutations.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of
+    /// the sequence permuted in place. The range used is [first,last), which contains all the elements
+    /// between first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @return a generator yielding a view on each permutation.
+    template <typename IT>
+    Generator<PermutationView<IT>> LazyPermutations(IT begin, IT end)
+    {
+      HeapPermutations<IT> permutations(begin, end);
+      for (auto it = permutations.begin(); it != permutations.end(); ++it)
+        co_yield *it;
+    }
+
+    /// Lazy Multiset Permutations - C++20 coroutine facade over MultisetPermutations.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of
+    /// the sequence permuted in place. The range used is [first,last), which contains all the elements
+    /// between first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @return a generator yielding a view on each distinct permutation.
+    template <typename IT>
+    Generator<PermutationView<IT>> LazyMultisetPermutations(IT begin, IT end)
+    {
+      MultisetPermutations<IT> permutations(begin, end);
+      for (auto it = permutations.begin(); it != permutations.end(); ++it)
+        co_yield *it;
+    }
+#endif
   }
 }
 
@@ -0,0 +1,342 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_COMBINATORY_SET_OPERATIONS_HXX
+#define MODULE_COMBINATORY_SET_OPERATIONS_HXX
+
+#include <Combinatory/intersection.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  namespace combinatory
+  {
+    /// Intersection - k-way intersection of sorted sequences written to an output iterator.
+    ///
+    /// @remark The keys of the smallest sequence are searched within the other ones using galloping
+    /// probes (cf. GallopingLowerBound); a key missing from a sequence makes the smallest sequence
+    /// skip ahead to the key found instead.
+    ///
+    /// @tparam IT type using to go through the collections (random-access for the complexity to hold).
+    /// @tparam OutputIT output iterator type.
+    ///
+    /// @param ranges the [first, last) ranges of the sorted sequences.
+    /// @param output iterator to the initial position of the destination sequence.
+    ///
+    /// @complexity O(k * n * log(m / n)) where n is the size of the smallest sequence.
+    ///
+    /// @warning the algorithm does not check the validity on data order.
+    ///
+    /// @return iterator to the end of the destination sequence: the sorted keys common to all the
+    /// sequences, dupplicate keys kept distinct (a key appears as many times as in the sequence having
+    /// the fewer occurences of it).
+    template <typename IT, typename OutputIT>
+    OutputIT Intersection(std::vector<std::pair<IT, IT>> ranges, OutputIT output)
+    {
+      typedef std::pair<IT, IT> Range;
+      if (ranges.empty())
+        return output;
+
+      // Smallest sequence first
+      std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b)
+      { return std::distance(a.first, a.second) < std::distance(b.first, b.second); });
+
+      const auto& kSmallest = ranges.front();
+      auto it = kSmallest.first;
+      while (it != kSmallest.second)
+      {
+        bool isCommon = true;
+        for (std::size_t i = 1; i < ranges.size() && isCommon; ++i)
+        {
+          auto& range = ranges[i];
+          range.first = GallopingLowerBound(range.first, range.second, *it);
+          if (range.first == range.second)
+            return output;
+
+          // Key missing: skip the smallest sequence keys lower than the one found
+          if (*it < *range.first)
+          {
+            it = GallopingLowerBound(it, kSmallest.second, *range.first);
+            isCommon = false;
+          }
+        }
+
+        // Key found everywhere: consume one of its occurences in each sequence
+        if (isCommon)
+        {
+          *output++ = *it;
+          ++it;
+          for (std::size_t i = 1; i < ranges.size(); ++i)
+            ++ranges[i].first;
+        }
+      }
+
+      return output;
+    }
+
+    /// Union - k-way union of sorted sequences written to an output iterator.
+    ///
+    /// @remark The sequences are merged using a heap of their current keys.
+    ///
+    /// @tparam IT type using to go through the collections.
+    /// @tparam OutputIT output iterator type.
+    ///
+    /// @param ranges the [first, last) ranges of the sorted sequences.
+    /// @param output iterator to the initial position of the destination sequence.
+    ///
+    /// @complexity O(N * log(k)) where N is the total number of keys.
+    ///
+    /// @warning the algorithm does not check the validity on data order.
+    ///
+    /// @return iterator to the end of the destination sequence: the sorted keys of all the sequences,
+    /// dupplicate keys kept distinct (a key appears as many times as in the sequence having the most
+    /// occurences of it).
+    template <typename IT, typename OutputIT>
+    OutputIT Union(std::vector<std::pair<IT, IT>> ranges, OutputIT output)
+    {
+      typedef std::pair<IT, IT> Range;
+
+      // Min-heap of the non-empty sequences on their current key
+      ranges.erase(std::remove_if(ranges.begin(), ranges.end(),
+                                  [](const Range& range) { return range.first == range.second; }),
+                   ranges.end());
+      auto lGreater = [](const Range& a, const Range& b) { return *b.first < *a.first; };
+      std::make_heap(ranges.begin(), ranges.end(), lGreater);
+
+      while (!ranges.empty())
+      {
+        // Count the occurences of the lowest key within each sequence
+        const auto kKey = *ranges.front().first;
+        std::size_t maxCount = 0;
+        while (!ranges.empty() && !(kKey < *ranges.front().first))
+        {
+          std::pop_heap(ranges.begin(), ranges.end(), lGreater);
+          auto& range = ranges.back();
+          std::size_t count = 0;
+          for (; range.first != range.second && !(kKey < *range.first); ++range.first)
+            ++count;
+          maxCount = std::max(maxCount, count);
+
+          if (range.first == range.second)
+            ranges.pop_back();
+          else
+            std::push_heap(ranges.begin(), ranges.end(), lGreater);
+        }
+
+        for (; maxCount > 0; --maxCount)
+          *output++ = kKey;
+      }
+
+      return output;
+    }
+
+    /// Difference - Keys of the first sorted sequence missing from all the other ones, written to an
+    /// output iterator.
+    ///
+    /// @remark The keys of the first sequence are searched within the other ones using galloping probes
+    /// (cf. GallopingLowerBound).
+    ///
+    /// @tparam IT type using to go through the collections (random-access for the complexity to hold).
+    /// @tparam OutputIT output iterator type.
+    ///
+    /// @param ranges the [first, last) ranges of the sorted sequences, the first one being the one the
+    /// others are subtracted from.
+    /// @param output iterator to the initial position of the destination sequence.
+    ///
+    /// @complexity O(k * n * log(m / n)) where n is the size of the first sequence.
+    ///
+    /// @warning the algorithm does not check the validity on data order.
+    ///
+    /// @return iterator to the end of the destination sequence: the sorted keys of the first sequence,
+    /// each occurence of a key within the other sequences removing one of its occurences.
+    template <typename IT, typename OutputIT>
+    OutputIT Difference(std::vector<std::pair<IT, IT>> ranges, OutputIT output)
+    {
+      if (ranges.empty())
+        return output;
+
+      const auto& kFirst = ranges.front();
+      for (auto it = kFirst.first; it != kFirst.second; ++it)
+      {
+        // Consume one occurence of the key within the first sequence containing it
+        bool isRemoved = false;
+        for (std::size_t i = 1; i < ranges.size() && !isRemoved; ++i)
+        {
+          auto& range = ranges[i];
+          range.first = GallopingLowerBound(range.first, range.second, *it);
+          if (range.first != range.second && !(*it < *range.first))
+          {
+            ++range.first;
+            isRemoved = true;
+          }
+        }
+
+        if (!isRemoved)
+          *output++ = *it;
+      }
+
+      return output;
+    }
+
+    /// Set Operations - Functors running the k-way set operations, to be used by ParallelSetOperation.
+    struct IntersectionOperation
+    {
+      template <typename IT, typename OutputIT>
+      OutputIT operator()(const std::vector<std::pair<IT, IT>>& ranges, OutputIT output) const
+      { return Intersection<IT, OutputIT>(ranges, output); }
+    };
+    struct UnionOperation
+    {
+      template <typename IT, typename OutputIT>
+      OutputIT operator()(const std::vector<std::pair<IT, IT>>& ranges, OutputIT output) const
+      { return Union<IT, OutputIT>(ranges, output); }
+    };
+    struct DifferenceOperation
+    {
+      template <typename IT, typename OutputIT>
+      OutputIT operator()(const std::vector<std::pair<IT, IT>>& ranges, OutputIT output) const
+      { return Difference<IT, OutputIT>(ranges, output); }
+    };
+
+    /// Parallel Set Operation - Run a k-way set operation on chunks of keys in parallel.
+    ///
+    /// The keys of the pivot sequence define the chunks boundaries: each chunk holds the keys within
+    /// [boundary, next boundary) of every sequence, all occurences of a key belonging to the same chunk.
+    /// Each chunk result is written to its own buffer, then the buffers are copied in order to the output.
+    ///
+    /// @tparam IT type using to go through the collections (random-access).
+    /// @tparam OutputIT output iterator type.
+    /// @tparam Operation functor type running the set operation (cf. IntersectionOperation).
+    ///
+    /// @param ranges the [first, last) ranges of the sorted sequences.
+    /// @param output iterator to the initial position of the destination sequence.
+    /// @param pivot index of the sequence used to define the chunks.
+    /// @param threads number of threads to be used (the sequential version is used for a single one or
+    /// small sequences).
+    ///
+    /// @return iterator to the end of the destination sequence.
+    template <typename Operation, typename IT, typename OutputIT>
+    OutputIT ParallelSetOperation(const std::vector<std::pair<IT, IT>>& ranges, OutputIT output,
+                                  std::size_t pivot, unsigned int threads)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef typename std::iterator_traits<IT>::difference_type Distance;
+      typedef std::pair<IT, IT> Range;
+      const Distance kMinChunkSize = 4096;
+
+      if (pivot >= ranges.size())
+        return output;
+
+      const auto& kPivot = ranges[pivot];
+      const auto kSize = std::distance(kPivot.first, kPivot.second);
+      threads = static_cast<unsigned int>(std::min<Distance>(std::max(1u, threads), kSize / kMinChunkSize));
+      if (threads < 2)
+        return Operation()(ranges, output);
+
+      // Chunk t ranges start at the lower bound of its first pivot key within each sequence
+      const Distance kChunkSize = (kSize + threads - 1) / threads;
+      std::vector<std::vector<Range>> chunks(threads, ranges);
+      for (unsigned int t = 1; t < threads; ++t)
+      {
+        const auto& kBoundary = *std::next(kPivot.first, std::min(kSize, t * kChunkSize));
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+          const auto kLimit = std::lower_bound(ranges[i].first, ranges[i].second, kBoundary);
+          chunks[t - 1][i].second = kLimit;
+          chunks[t][i].first = kLimit;
+        }
+      }
+
+      std::vector<std::vector<Value>> results(threads);
+      std::vector<std::thread> workers;
+      for (unsigned int t = 0; t < threads; ++t)
+        workers.push_back(std::thread([&chunks, &results, t]()
+        { Operation()(chunks[t], std::back_inserter(results[t])); }));
+      for (auto it = workers.begin(); it != workers.end(); ++it)
+        it->join();
+
+      for (auto it = results.begin(); it != results.end(); ++it)
+        output = std::copy(it->begin(), it->end(), output);
+      return output;
+    }
+
+    /// Parallel Intersection - Multi-threaded version of the k-way Intersection, chunks being defined on
+    /// the smallest sequence.
+    ///
+    /// @param ranges the [first, last) ranges of the sorted sequences.
+    /// @param output iterator to the initial position of the destination sequence.
+    /// @param threads number of threads to be used (the sequential version is used for a single one or
+    /// small sequences).
+    ///
+    /// @return iterator to the end of the destination sequence.
+    template <typename IT, typename OutputIT>
+    OutputIT ParallelIntersection(const std::vector<std::pair<IT, IT>>& ranges, OutputIT output,
+                                  unsigned int threads = std::thread::hardware_concurrency())
+    {
+      typedef std::pair<IT, IT> Range;
+      const auto kSmallest = std::min_element(ranges.begin(), ranges.end(), [](const Range& a, const Range& b)
+      { return std::distance(a.first, a.second) < std::distance(b.first, b.second); });
+      const auto kPivot = static_cast<std::size_t>(std::distance(ranges.begin(), kSmallest));
+      return ParallelSetOperation<IntersectionOperation>(ranges, output, kPivot, threads);
+    }
+
+    /// Parallel Union - Multi-threaded version of the k-way Union, chunks being defined on the largest
+    /// sequence.
+    ///
+    /// @param ranges the [first, last) ranges of the sorted sequences.
+    /// @param output iterator to the initial position of the destination sequence.
+    /// @param threads number of threads to be used (the sequential version is used for a single one or
+    /// small sequences).
+    ///
+    /// @return iterator to the end of the destination sequence.
+    template <typename IT, typename OutputIT>
+    OutputIT ParallelUnion(const std::vector<std::pair<IT, IT>>& ranges, OutputIT output,
+                           unsigned int threads = std::thread::hardware_concurrency())
+    {
+      typedef std::pair<IT, IT> Range;
+      const auto kLargest = std::max_element(ranges.begin(), ranges.end(), [](const Range& a, const Range& b)
+      { return std::distance(a.first, a.second) < std::distance(b.first, b.second); });
+      const auto kPivot = static_cast<std::size_t>(std::distance(ranges.begin(), kLargest));
+      return ParallelSetOperation<UnionOperation>(ranges, output, kPivot, threads);
+    }
+
+    /// Parallel Difference - Multi-threaded version of the k-way Difference, chunks being defined on the
+    /// first sequence.
+    ///
+    /// @param ranges the [first, last) ranges of the sorted sequences.
+    /// @param output iterator to the initial position of the destination sequence.
+    /// @param threads number of threads to be used (the sequential version is used for a single one or
+    /// small sequences).
+    ///
+    /// @return iterator to the end of the destination sequence.
+    template <typename IT, typename OutputIT>
+    OutputIT ParallelDifference(const std::vector<std::pair<IT, IT>>& ranges, OutputIT output,
+                                unsigned int threads = std::thread::hardware_concurrency())
+    { return ParallelSetOperation<DifferenceOperation>(ranges, output, 0, threads); }
+  }
+}
+
+#endif // MODULE_COMBINATORY_SET_OPERATIONS_HXX
@@ -0,0 +1,161 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <avl_tree.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Simple sorted array of integers with negative values
+  const int SortedArrayInt[] = {-3, -2, 0, 2, 8, 15, 36, 212, 366};
+  // Simple random array of integers with negative values
+  const int RandomArrayInt[] = {4, 3, 5, 2, -18, 3, 2, 3, 4, 5, -5};
+
+  template <typename T>
+  struct EQUAL
+  {
+    bool operator() (const T& a, const T& b) const { return a == b; }
+  };
+
+  typedef std::vector<int> Container;
+  typedef Container::value_type Value;
+  typedef Container::const_iterator Const_IT;
+  typedef AVL<Const_IT, std::less_equal<int>, EQUAL<int>> Const_AVL;
+  typedef std::unique_ptr<Const_AVL> Const_Own_AVL;
+
+  // Maximal height of an AVL tree composed of n nodes
+  int MaxAVLHeight(std::size_t n) { return static_cast<int>(1.44 * std::log2(static_cast<double>(n) + 2)); }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test AVL Construction
+TEST(TestAVL, build)
+{
+  // Empty Array - No tree should be built
+  {
+    const Container kEmptyCollection = Container();
+    Const_Own_AVL tree = Const_AVL::Build(kEmptyCollection.begin(), kEmptyCollection.end());
+    EXPECT_FALSE(tree);
+  }
+
+  // Sorted sequence - Rotations should keep the tree balanced
+  {
+    const Container kSorted(SortedArrayInt, SortedArrayInt + sizeof(SortedArrayInt) / sizeof(Value));
+    Const_Own_AVL tree = Const_AVL::Build(kSorted.begin(), kSorted.end());
+    EXPECT_EQ(kSorted.size(), tree->Size());
+    EXPECT_EQ(2, tree->GetRoot()->GetData());
+    EXPECT_EQ(4, tree->GetHeight());
+    EXPECT_TRUE(tree->IsValid());
+    EXPECT_TRUE(tree->IsBlanced());
+  }
+
+  // Basic construction with negative values and dupplicates
+  {
+    const Container kRandIntArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
+    Const_Own_AVL tree = Const_AVL::Build(kRandIntArray.begin(), kRandIntArray.end());
+    EXPECT_EQ(kRandIntArray.size(), tree->Size());
+    EXPECT_TRUE(tree->IsValid());
+    EXPECT_TRUE(tree->IsBlanced());
+  }
+}
+
+// Test AVL Find, Insert and Remove
+TEST(TestAVL, FindInsertRemove)
+{
+  const Container kRandIntArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
+  Const_Own_AVL tree = Const_AVL::Build(kRandIntArray.begin(), kRandIntArray.end());
+  EXPECT_EQ(-18, tree->Find(-18)->GetData());
+  EXPECT_EQ(5, tree->Find(5)->GetData());
+  EXPECT_FALSE(tree->Find(1));
+
+  tree->Insert(1);
+  EXPECT_EQ(1, tree->Find(1)->GetData());
+  EXPECT_EQ(kRandIntArray.size() + 1, tree->Size());
+
+  // All dupplicates are removed
+  EXPECT_EQ(3u, tree->Remove(3));
+  EXPECT_FALSE(tree->Find(3));
+  EXPECT_EQ(0u, tree->Remove(3));
+  EXPECT_EQ(kRandIntArray.size() - 2, tree->Size());
+  EXPECT_TRUE(tree->IsValid());
+  EXPECT_TRUE(tree->IsBlanced());
+
+  // Tree may be emptied
+  const Container kSorted(SortedArrayInt, SortedArrayInt + sizeof(SortedArrayInt) / sizeof(Value));
+  Const_Own_AVL sortedTree = Const_AVL::Build(kSorted.begin(), kSorted.end());
+  for (auto it = kSorted.begin(); it != kSorted.end(); ++it)
+    EXPECT_EQ(1u, sortedTree->Remove(*it));
+  EXPECT_EQ(0u, sortedTree->Size());
+  EXPECT_EQ(0, sortedTree->GetHeight());
+  EXPECT_FALSE(sortedTree->GetRoot());
+}
+
+// Test balancement whatever the insertion order
+TEST(TestAVL, Balancement)
+{
+  // Large sorted sequence - a naive BST would degenerate into a list
+  {
+    Container sorted(100000);
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+      sorted[i] = static_cast<int>(i);
+
+    Const_Own_AVL tree = Const_AVL::Build(sorted.begin(), sorted.end());
+    EXPECT_LE(tree->GetHeight(), MaxAVLHeight(sorted.size()));
+    EXPECT_TRUE(tree->IsValid());
+    EXPECT_TRUE(tree->IsBlanced());
+    EXPECT_EQ(99999, tree->Find(99999)->GetData());
+
+    // Remove every other key
+    for (std::size_t i = 0; i < sorted.size(); i += 2)
+      tree->Remove(sorted[i]);
+    EXPECT_EQ(sorted.size() / 2, tree->Size());
+    EXPECT_LE(tree->GetHeight(), MaxAVLHeight(tree->Size()));
+    EXPECT_TRUE(tree->IsBlanced());
+    EXPECT_FALSE(tree->Find(0));
+    EXPECT_EQ(1, tree->Find(1)->GetData());
+  }
+
+  // Random insertions and removals with many dupplicates
+  {
+    std::mt19937 generator(7);
+    Container keys(20000);
+    for (auto it = keys.begin(); it != keys.end(); ++it)
+      *it = static_cast<int>(generator() % 1000);
+
+    Const_Own_AVL tree = Const_AVL::Build(keys.begin(), keys.end());
+    for (int key = 0; key < 1000; key += 3)
+    {
+      const auto kCount = static_cast<std::size_t>(std::count(keys.begin(), keys.end(), key));
+      EXPECT_EQ(kCount, tree->Remove(key));
+    }
+    EXPECT_TRUE(tree->IsValid());
+    EXPECT_TRUE(tree->IsBlanced());
+    EXPECT_LE(tree->GetHeight(), MaxAVLHeight(tree->Size()));
+    EXPECT_FALSE(tree->Find(999));
+    EXPECT_TRUE(tree->Find(998) || std::count(keys.begin(), keys.end(), 998) == 0);
+  }
+}
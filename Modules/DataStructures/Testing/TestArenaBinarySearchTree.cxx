@@ -0,0 +1,150 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <arena_binary_search_tree.hxx>
+#include <binary_search_tree.hxx>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Simple sorted array of integers with negative values
+  const int SortedArrayInt[] = {-3, -2, 0, 2, 8, 15, 36, 212, 366};
+  // Simple random array of integers with negative values
+  const int RandomArrayInt[] = {4, 3, 5, 2, -18, 3, 2, 3, 4, 5, -5};
+
+  template <typename T>
+  struct EQUAL
+  {
+    bool operator() (const T& a, const T& b) const { return a == b; }
+  };
+
+  typedef std::vector<int> Container;
+  typedef Container::value_type Value;
+  typedef Container::const_iterator Const_IT;
+  typedef ArenaBST<Const_IT, std::less_equal<int>, EQUAL<int>> Const_Arena_BST;
+  typedef std::unique_ptr<Const_Arena_BST> Const_Own_Arena_BST;
+  typedef BST<Const_IT, std::less_equal<int>, EQUAL<int>> Const_BST;
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test Arena BST Construction
+TEST(TestArenaBST, build)
+{
+  // Empty Array - No tree should be built
+  {
+    const Container kEmptyCollection = Container();
+    EXPECT_FALSE(Const_Arena_BST::Build(kEmptyCollection.begin(), kEmptyCollection.end()));
+    EXPECT_FALSE(Const_Arena_BST::BuildFromSorted(kEmptyCollection.begin(), kEmptyCollection.end()));
+  }
+
+  // Same shape as the pointer based BST
+  {
+    const Container kRandIntArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
+    Const_Own_Arena_BST tree = Const_Arena_BST::Build(kRandIntArray.begin(), kRandIntArray.end());
+    auto reference = Const_BST::Build(kRandIntArray.begin(), kRandIntArray.end());
+    EXPECT_EQ(kRandIntArray.size(), tree->Size());
+    EXPECT_EQ(reference->MaxHeight(), tree->MaxHeight());
+    EXPECT_EQ(reference->MinHeight(), tree->MinHeight());
+    EXPECT_TRUE(tree->IsValid());
+  }
+
+  // Balanced construction on sorted array
+  {
+    const Container kSorted(SortedArrayInt, SortedArrayInt + sizeof(SortedArrayInt) / sizeof(Value));
+    Const_Own_Arena_BST tree = Const_Arena_BST::BuildFromSorted(kSorted.begin(), kSorted.end());
+    EXPECT_EQ(kSorted.size(), tree->Size());
+    EXPECT_TRUE(tree->IsValid());
+    EXPECT_TRUE(tree->IsBlanced());
+  }
+
+  // Wrong construction on unsorted array
+  {
+    const Container kRandIntArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
+    Const_Own_Arena_BST tree = Const_Arena_BST::BuildFromSorted(kRandIntArray.begin(), kRandIntArray.end());
+    EXPECT_FALSE(tree->IsValid());
+  }
+}
+
+// Test Arena BST Find, Insert and Remove
+TEST(TestArenaBST, FindInsertRemove)
+{
+  const Container kRandIntArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
+  Const_Own_Arena_BST tree = Const_Arena_BST::Build(kRandIntArray.begin(), kRandIntArray.end());
+  EXPECT_EQ(-18, *tree->Find(-18));
+  EXPECT_EQ(5, *tree->Find(5));
+  EXPECT_FALSE(tree->Find(1));
+
+  // All dupplicates are removed
+  EXPECT_EQ(3u, tree->Remove(3));
+  EXPECT_FALSE(tree->Find(3));
+  EXPECT_EQ(0u, tree->Remove(3));
+  EXPECT_EQ(2u, tree->Remove(4));
+  EXPECT_EQ(kRandIntArray.size() - 5, tree->Size());
+  EXPECT_TRUE(tree->IsValid());
+
+  // Removed nodes are recycled
+  const auto kCapacity = tree->GetCapacity();
+  for (int i = 0; i < 5; ++i)
+    tree->Insert(100 + i);
+  EXPECT_EQ(kCapacity, tree->GetCapacity());
+  EXPECT_EQ(kRandIntArray.size(), tree->Size());
+  EXPECT_EQ(104, *tree->Find(104));
+  EXPECT_TRUE(tree->IsValid());
+}
+
+// Test large trees, both degenerated and random
+TEST(TestArenaBST, LargeTrees)
+{
+  // Sorted sequence - a list deeper than recursive calls would handle well
+  {
+    Container sorted(30000);
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+      sorted[i] = static_cast<int>(i);
+
+    Const_Own_Arena_BST tree = Const_Arena_BST::Build(sorted.begin(), sorted.end());
+    EXPECT_EQ(sorted.size(), tree->MaxHeight());
+    EXPECT_EQ(1u, tree->MinHeight());
+    EXPECT_TRUE(tree->IsValid());
+    EXPECT_EQ(29999, *tree->Find(29999));
+    EXPECT_EQ(1u, tree->Remove(29999));
+    EXPECT_EQ(1u, tree->Remove(0));
+    EXPECT_EQ(sorted.size() - 2, tree->MaxHeight());
+  }
+
+  // Random sequence with dupplicates - removals match the number of occurences
+  {
+    std::mt19937 generator(3);
+    Container keys(50000);
+    for (auto it = keys.begin(); it != keys.end(); ++it)
+      *it = static_cast<int>(generator() % 5000);
+
+    Const_Own_Arena_BST tree = Const_Arena_BST::Build(keys.begin(), keys.end());
+    for (int key = 0; key < 5000; key += 7)
+      EXPECT_EQ(static_cast<std::size_t>(std::count(keys.begin(), keys.end(), key)), tree->Remove(key));
+    EXPECT_TRUE(tree->IsValid());
+    EXPECT_FALSE(tree->Find(7));
+  }
+}
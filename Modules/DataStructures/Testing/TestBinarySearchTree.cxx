@@ -20,8 +20,10 @@
 #include <gtest/gtest.h>
 #include <binary_search_tree.hxx>
 
+#include <algorithm>
 #include <functional>
 #include <list>
+#include <random>
 
 using namespace huc;
 
@@ -223,7 +225,7 @@ TEST(TestBST, Size)
   {
     const Container kSmallIntArray(SmallIntArray, SmallIntArray + sizeof(SmallIntArray) / sizeof(Value));
     Const_Own_BST tree = Const_BST::Build(kSmallIntArray.begin(), kSmallIntArray.begin() + 1);
-    EXPECT_EQ(1, tree->Size());
+    EXPECT_EQ(1u, tree->Size());
   }
 
   // Basic construction - 3
@@ -256,14 +258,14 @@ TEST(TestBST, MinHeight)
   {
     const Container kSmallIntArray(SmallIntArray, SmallIntArray + sizeof(SmallIntArray) / sizeof(Value));
     Const_Own_BST tree = Const_BST::Build(kSmallIntArray.begin(), kSmallIntArray.begin() + 1);
-    EXPECT_EQ(1, tree->MinHeight());
+    EXPECT_EQ(1u, tree->MinHeight());
   }
 
   // Basic construction
   {
     const Container kSmallIntArray(SmallIntArray, SmallIntArray + sizeof(SmallIntArray) / sizeof(Value));
     Const_Own_BST tree = Const_BST::Build(kSmallIntArray.begin(), kSmallIntArray.end());
-    EXPECT_EQ(2, tree->MinHeight());
+    EXPECT_EQ(2u, tree->MinHeight());
   }
 
   // Basic construction on sorted array
@@ -271,14 +273,14 @@ TEST(TestBST, MinHeight)
     const Container kSmallSorted(SmallIntArraySorted,
                                  SmallIntArraySorted + sizeof(SmallIntArraySorted) / sizeof(Value));
     Const_Own_BST tree = Const_BST::BuildFromSorted(kSmallSorted.begin(), kSmallSorted.end());
-    EXPECT_EQ(2, tree->MinHeight());
+    EXPECT_EQ(2u, tree->MinHeight());
   }
 
   // Basic construction with negative values and dupplicates
   {
     const Container kRandIntArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
     Const_Own_BST tree = Const_BST::Build(kRandIntArray.begin(), kRandIntArray.end());
-    EXPECT_EQ(2, tree->MinHeight());
+    EXPECT_EQ(2u, tree->MinHeight());
   }
 }
 
@@ -289,14 +291,14 @@ TEST(TestBST, MaxHeight)
   {
     const Container kSmallIntArray(SmallIntArray, SmallIntArray + sizeof(SmallIntArray) / sizeof(Value));
     Const_Own_BST tree = Const_BST::Build(kSmallIntArray.begin(), kSmallIntArray.begin() + 1);
-    EXPECT_EQ(1, tree->MaxHeight());
+    EXPECT_EQ(1u, tree->MaxHeight());
   }
 
   // Basic construction
   {
     const Container kSmallIntArray(SmallIntArray, SmallIntArray + sizeof(SmallIntArray) / sizeof(Value));
     Const_Own_BST tree = Const_BST::Build(kSmallIntArray.begin(), kSmallIntArray.end());
-    EXPECT_EQ(2, tree->MaxHeight());
+    EXPECT_EQ(2u, tree->MaxHeight());
   }
 
   // Basic construction on sorted array
@@ -304,14 +306,14 @@ TEST(TestBST, MaxHeight)
     const Container kSmallSorted(SmallIntArraySorted,
                                  SmallIntArraySorted + sizeof(SmallIntArraySorted) / sizeof(Value));
     Const_Own_BST tree = Const_BST::BuildFromSorted(kSmallSorted.begin(), kSmallSorted.end());
-    EXPECT_EQ(2, tree->MaxHeight());
+    EXPECT_EQ(2u, tree->MaxHeight());
   }
 
   // Basic construction with negative values and dupplicates
   {
     const Container kRandIntArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
     Const_Own_BST tree = Const_BST::Build(kRandIntArray.begin(), kRandIntArray.end());
-    EXPECT_EQ(6, tree->MaxHeight());
+    EXPECT_EQ(6u, tree->MaxHeight());
   }
 }
 
@@ -484,7 +486,7 @@ TEST(TestBST, Remove)
     EXPECT_EQ(1, tree->GetRightChild()->GetData());
     ASSERT_TRUE(tree->GetLeftChild());
     EXPECT_EQ(-2, tree->GetLeftChild()->GetData());
-    EXPECT_EQ(3, tree->GetLeftChild()->Size());
+    EXPECT_EQ(3u, tree->GetLeftChild()->Size());
   }
 
   // Root node with a unique subtree child (right)
@@ -505,7 +507,7 @@ TEST(TestBST, Remove)
     EXPECT_EQ(3, tree->GetLeftChild()->GetData());
     ASSERT_TRUE(tree->GetRightChild());
     EXPECT_EQ(6, tree->GetRightChild()->GetData());
-    EXPECT_EQ(3, tree->GetRightChild()->Size());
+    EXPECT_EQ(3u, tree->GetRightChild()->Size());
   }
 
   // Root node with two childred
@@ -539,10 +541,77 @@ TEST(TestBST, Remove)
     ASSERT_TRUE(tree);
     EXPECT_EQ(tree.get(), returnTreePtr);
     EXPECT_EQ(8, tree->GetData());
-    EXPECT_EQ(8, tree->Size());
+    EXPECT_EQ(8u, tree->Size());
     ASSERT_TRUE(tree->GetRightChild());
-    EXPECT_EQ(3, tree->GetRightChild()->Size());
+    EXPECT_EQ(3u, tree->GetRightChild()->Size());
     ASSERT_TRUE(tree->GetLeftChild()->GetRightChild());
     ASSERT_EQ(7, tree->GetLeftChild()->GetRightChild()->GetData());
   }
 }
+
+// Test degenerated tree - operations should not depend on the call stack depth
+TEST(TestBST, DegeneratedTree)
+{
+  Container sorted(20000);
+  for (std::size_t i = 0; i < sorted.size(); ++i)
+    sorted[i] = static_cast<int>(i);
+
+  Const_Own_BST tree = Const_BST::Build(sorted.begin(), sorted.end());
+  EXPECT_EQ(sorted.size(), tree->Size());
+  EXPECT_EQ(sorted.size(), tree->MaxHeight());
+  EXPECT_EQ(1u, tree->MinHeight());
+  EXPECT_TRUE(tree->IsValid());
+  EXPECT_FALSE(tree->IsBlanced());
+  EXPECT_EQ(19999, tree->Find(19999)->GetData());
+
+  tree->Insert(19999);
+  EXPECT_EQ(1, Const_BST::Remove(tree, 0)->GetData());
+  Const_BST::Remove(tree, 19999);
+  EXPECT_EQ(sorted.size() - 2, tree->Size());
+  EXPECT_FALSE(tree->Find(19999));
+}
+
+// Test order statistics - Rank, Select and Count compared to a sorted sequence
+TEST(TestBST, OrderStatistics)
+{
+  // Basic construction with negative values and dupplicates
+  {
+    const Container kRandIntArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(Value));
+    Const_Own_BST tree = Const_BST::Build(kRandIntArray.begin(), kRandIntArray.end());
+    EXPECT_EQ(0u, tree->Rank(-18));
+    EXPECT_EQ(2u, tree->Rank(2));
+    EXPECT_EQ(kRandIntArray.size(), tree->Rank(6));
+    EXPECT_EQ(-18, tree->Select(0)->GetData());
+    EXPECT_EQ(5, tree->Select(kRandIntArray.size() - 1)->GetData());
+    EXPECT_FALSE(tree->Select(kRandIntArray.size()));
+    EXPECT_EQ(5u, tree->Count(2, 3));
+    EXPECT_EQ(0u, tree->Count(3, 2));
+    EXPECT_EQ(kRandIntArray.size(), tree->Count(-20, 20));
+  }
+
+  // Random insertions and removals
+  {
+    std::mt19937 generator(11);
+    Container keys(5000);
+    for (auto it = keys.begin(); it != keys.end(); ++it)
+      *it = static_cast<int>(generator() % 1000);
+
+    Const_Own_BST tree = Const_BST::Build(keys.begin(), keys.end());
+    for (int key = 0; key < 1000; key += 5)
+      Const_BST::Remove(tree, key);
+    keys.erase(std::remove_if(keys.begin(), keys.end(), [](int key) { return key % 5 == 0; }), keys.end());
+    std::sort(keys.begin(), keys.end());
+
+    ASSERT_EQ(keys.size(), tree->Size());
+    EXPECT_TRUE(tree->IsValid());
+    for (std::size_t k = 0; k < keys.size(); k += 7)
+      EXPECT_EQ(keys[k], tree->Select(k)->GetData());
+    for (int key = -1; key <= 1000; key += 3)
+    {
+      const auto kLower = std::lower_bound(keys.begin(), keys.end(), key);
+      const auto kUpper = std::upper_bound(keys.begin(), keys.end(), key + 10);
+      EXPECT_EQ(static_cast<std::size_t>(kLower - keys.begin()), tree->Rank(key));
+      EXPECT_EQ(static_cast<std::size_t>(kUpper - kLower), tree->Count(key, key + 10));
+    }
+  }
+}
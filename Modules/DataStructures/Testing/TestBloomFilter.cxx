@@ -0,0 +1,103 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <bloom_filter.hxx>
+
+// STD includes
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace huc;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  typedef std::vector<int> Container;
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test Bloom Filter probes
+TEST(TestBloomFilter, MayContain)
+{
+  // Empty filter - nothing found
+  {
+    BloomFilter<int> filter(0);
+    EXPECT_EQ(static_cast<size_t>(1), filter.GetBlockCount());
+    for (int key = -100; key < 100; ++key)
+      EXPECT_FALSE(filter.MayContain(key));
+  }
+
+  // No false negatives and about 1% of false positives using 10 bits per key
+  {
+    const std::size_t kSize = 100000;
+    std::mt19937 generator(3);
+    Container keys(kSize);
+    for (auto it = keys.begin(); it != keys.end(); ++it)
+      *it = static_cast<int>(generator() >> 1);  // Positive keys
+
+    BloomFilter<int> filter(kSize);
+    filter.Insert(keys.begin(), keys.end());
+    EXPECT_GE(filter.GetMemorySize(), static_cast<size_t>(kSize * 10 / 8));
+    EXPECT_LT(filter.GetMemorySize(), static_cast<size_t>(kSize * 10 / 8 + 32));
+
+    for (auto it = keys.begin(); it != keys.end(); ++it)
+      EXPECT_TRUE(filter.MayContain(*it));
+
+    std::size_t falsePositives = 0;
+    for (int key = -1; key >= -static_cast<int>(kSize); --key)
+      falsePositives += filter.MayContain(key) ? 1 : 0;
+    EXPECT_LT(falsePositives, kSize / 50);
+  }
+
+  // String keys
+  {
+    BloomFilter<std::string> filter(3);
+    filter.Insert("interleave");
+    filter.Insert("intersection");
+    EXPECT_TRUE(filter.MayContain("interleave"));
+    EXPECT_TRUE(filter.MayContain("intersection"));
+  }
+}
+
+// Test Bloom Filter batched probes
+TEST(TestBloomFilter, Filter)
+{
+  Container keys;
+  for (int key = 0; key < 2000; key += 3)
+    keys.push_back(key);
+
+  BloomFilter<int> filter(keys.size(), 4);
+  filter.Insert(keys.begin(), keys.end());
+
+  // Same keys as the ones probed one by one, in the same order
+  Container probes;
+  for (int key = 0; key < 5000; ++key)
+    probes.push_back(key);
+  Container expected;
+  for (auto it = probes.begin(); it != probes.end(); ++it)
+    if (filter.MayContain(*it))
+      expected.push_back(*it);
+
+  Container candidates;
+  filter.Filter(probes.begin(), probes.end(), std::back_inserter(candidates));
+  EXPECT_EQ(expected, candidates);
+  EXPECT_GE(candidates.size(), keys.size());
+}
@@ -0,0 +1,389 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DATA_STRUCTURES_ARENA_BST_HXX
+#define MODULE_DATA_STRUCTURES_ARENA_BST_HXX
+
+// STD includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  /// @class ArenaBST
+  ///
+  /// Binary Search Tree (cf. BST) following the same ordering rules and producing the same shapes, whose
+  /// nodes are stored within an arena: contiguous chunks of nodes linked with 32 bits indices instead of
+  /// one heap allocation per node. Removed nodes are recycled through a free list chained by their
+  /// left index.
+  ///
+  /// All operations are iterative: degenerated trees (e.g. built from a sorted sequence) are supported
+  /// whatever their height.
+  ///
+  /// @advantages
+  /// - One allocation every kChunkSize insertions; nodes allocated together are close in memory.
+  /// - 8 bytes of links per node instead of 16 bytes of pointers.
+  /// - Destruction releases chunks, not nodes: no recursive destructor.
+  ///
+  /// @drawbacks
+  /// - Memory of removed nodes is only recycled, never released until the tree is destroyed.
+  /// - Capacity is limited to 2^32 - 2^12 nodes (std::length_error thrown beyond).
+  ///
+  /// @tparam IT type of the iterators on the sequences used to build the tree.
+  /// @tparam Compare functor type ordering the keys (e.g. less_equal).
+  /// @tparam IsEqual functor type used to identify a key.
+  template <typename IT, typename Compare, typename IsEqual>
+  class ArenaBST
+  {
+    typedef typename std::iterator_traits<IT>::value_type Value;
+
+    static const std::uint32_t kNull = 0xFFFFFFFF;  // Null link
+    static const int kChunkBits = 12;               // Chunks of 4096 nodes
+    static const std::uint32_t kChunkSize = 1u << kChunkBits;
+
+    struct Node
+    {
+      Node(const Value& data) : data(data), leftChild(kNull), rightChild(kNull) {}
+
+      Value data;
+      std::uint32_t leftChild;   // Left child index, next free node once recycled
+      std::uint32_t rightChild;  // Right child index
+    };
+
+  public:
+    /// Build - Construct in a naive way a Binary Search Tree given an unordered sequence of elements.
+    ///
+    /// @param begin,end - ITs to the initial and final positions of
+    /// the sequence used to build the tree. The range used is [first,last), which contains
+    /// all the elements between first and last, including the element pointed by first but
+    /// not the element pointed by last.
+    ///
+    /// @complexity O(n * h).
+    ///
+    /// @return Binary Search Tree pointer to be owned, nullptr if construction failed.
+    static std::unique_ptr<ArenaBST> Build(const IT& begin, const IT& end)
+    {
+      if (begin >= end)
+        return nullptr;
+
+      auto tree = std::unique_ptr<ArenaBST>(new ArenaBST());
+      for (auto it = begin; it != end; ++it)
+        tree->Insert(*it);
+
+      return tree;
+    }
+
+    /// BuildFromSorted - Construct a Balanced Binary Search Tree given an ordered sequence of elements.
+    ///
+    /// @param begin,end - ITs to the initial and final positions of
+    /// the sequence used to build the tree. The range used is [first,last), which contains
+    /// all the elements between first and last, including the element pointed by first but
+    /// not the element pointed by last.
+    ///
+    /// @complexity O(n).
+    ///
+    /// @warning the algorithm does not check the validity on data order; using this algorithm with
+    /// unordored data will most likely result in an invalid BST. (Can be checked using IsValid method).
+    ///
+    /// @return Binary Search Tree pointer to be owned, nullptr if construction failed.
+    static std::unique_ptr<ArenaBST> BuildFromSorted(const IT& begin, const IT& end)
+    {
+      if (begin >= end)
+        return nullptr;
+
+      auto tree = std::unique_ptr<ArenaBST>(new ArenaBST());
+      tree->root = tree->AllocateSorted(begin, end);
+      tree->size = static_cast<std::size_t>(std::distance(begin, end));
+      return tree;
+    }
+
+    /// Find the first node of the tree matching a specific key.
+    ///
+    /// @complexity O(h), where h may be n in worst case balancement. Equal to log(n) with a balanced tree.
+    ///
+    /// @param data, data value to be found within the tree.
+    ///
+    /// @return pointer on the first key matching the data, nullptr if not found.
+    const Value* Find(const Value& data) const
+    {
+      auto index = this->root;
+      while (index != kNull)
+      {
+        const auto& node = this->At(index);
+        if (IsEqual()(node.data, data))
+          return &node.data;
+
+        index = Compare()(data, node.data) ? node.leftChild : node.rightChild;
+      }
+
+      return nullptr;
+    }
+
+    /// Append a new node at the right position with current value.
+    ///
+    /// @complexity O(h).
+    ///
+    /// @param data data value to be added to the tree. Member type Value is the type of the
+    /// elements in the tree, defined as an alias of its first template parameter Value
+    /// (IT::Value).
+    ///
+    /// @warning throws std::length_error if the capacity of the arena is exceeded, the tree remaining
+    /// unchanged.
+    ///
+    /// @return void.
+    void Insert(const Value& data)
+    {
+      // Reach the empty link the key belongs to
+      auto* link = &this->root;
+      while (*link != kNull)
+      {
+        auto& node = this->At(*link);
+        link = Compare()(data, node.data) ? &node.leftChild : &node.rightChild;
+      }
+
+      // Link pointers remain valid as chunks are never reallocated
+      *link = this->Allocate(data);
+      ++this->size;
+    }
+
+    /// Removes all elements equal [IsEqual() template parameter] to the value from the tree.
+    ///
+    /// @param data to be removed from the tree. All elements with a value equivalent (IsEqual template
+    /// parameter) to this are removed from the container.
+    ///
+    /// @complexity O(k * h), k being the number of elements removed.
+    ///
+    /// @return the number of elements removed.
+    std::size_t Remove(const Value& data)
+    {
+      std::size_t count = 0;
+      for (auto* link = this->FindLink(data); *link != kNull; link = this->FindLink(data), ++count)
+      {
+        auto index = *link;
+        auto& node = this->At(index);
+
+        // At most one child - replace node with it
+        if (node.leftChild == kNull || node.rightChild == kNull)
+          *link = (node.leftChild != kNull) ? node.leftChild : node.rightChild;
+        // Both children:
+        // - Swap node value with its predecessor
+        // - Remove predecessor node and replace it with its child
+        else
+        {
+          auto* predecessor = &node.leftChild;
+          while (this->At(*predecessor).rightChild != kNull)
+            predecessor = &this->At(*predecessor).rightChild;
+
+          index = *predecessor;
+          std::swap(node.data, this->At(index).data);
+          *predecessor = this->At(index).leftChild;
+        }
+
+        this->Release(index);
+      }
+
+      this->size -= count;
+      return count;
+    }
+
+    /// Check if the Binary Search Tree is balanced.
+    /// Compare the smallest branch to the biggest one to determine the balancement.
+    ///
+    /// @return wheter or not the tree is balanced (true) or not (false).
+    bool IsBlanced() const { return this->MaxHeight() - this->MinHeight() <= 1; }
+
+    /// Check validity of the Binary Search Tree: the in-order sequence of keys must respect the
+    /// Compare operator.
+    ///
+    /// @complexity O(n), using an explicit stack of O(h) indices.
+    ///
+    /// @return wheter or not the tree is a valid Binary Search Tree (true) or not (false).
+    bool IsValid() const
+    {
+      std::vector<std::uint32_t> stack;
+      const Node* previousNode = nullptr;
+      for (auto index = this->root; index != kNull || !stack.empty(); )
+      {
+        // Stack the left branch
+        for (; index != kNull; index = this->At(index).leftChild)
+          stack.push_back(index);
+
+        const auto& node = this->At(stack.back());
+        stack.pop_back();
+
+        // Previous data does not compare well to the current one - BST not valid
+        if (previousNode && !Compare()(previousNode->data, node.data))
+          return false;
+
+        previousNode = &node;
+        index = node.rightChild;
+      }
+
+      return true;
+    }
+
+    /// Returns the biggest branch height.
+    ///
+    /// Complexity O(n).
+    ///
+    /// @return biggest branch height composing the tree.
+    std::size_t MaxHeight() const
+    {
+      std::size_t height = 0;
+      this->VisitBranchEnds([&](std::size_t depth) { height = std::max(height, depth); });
+      return height;
+    }
+
+    /// Returns the smallest branch height.
+    ///
+    /// Complexity O(n).
+    ///
+    /// @return smallest branch height composing the tree.
+    std::size_t MinHeight() const
+    {
+      std::size_t height = 0;
+      this->VisitBranchEnds([&](std::size_t depth)
+                            { height = (height == 0) ? depth : std::min(height, depth); });
+      return height;
+    }
+
+    /// Complexity O(1).
+    ///
+    /// @return number of nodes composing the tree.
+    std::size_t Size() const { return this->size; }
+
+    /// @return the number of nodes allocated by the arena (removed nodes included).
+    std::size_t GetCapacity() const { return this->chunks.size() * kChunkSize; }
+
+  private:
+    ArenaBST() : root(kNull), freeNode(kNull), size(0) {}
+    ArenaBST(ArenaBST&) {}           // Not Implemented
+    ArenaBST operator=(ArenaBST&) {} // Not Implemented
+
+    Node& At(std::uint32_t index) { return this->chunks[index >> kChunkBits][index & (kChunkSize - 1)]; }
+    const Node& At(std::uint32_t index) const
+    { return this->chunks[index >> kChunkBits][index & (kChunkSize - 1)]; }
+
+    /// Allocate - Recycle a free node or append one to the last chunk.
+    ///
+    /// @return the index of the node.
+    std::uint32_t Allocate(const Value& data)
+    {
+      if (this->freeNode != kNull)
+      {
+        const auto kIndex = this->freeNode;
+        this->freeNode = this->At(kIndex).leftChild;
+        this->At(kIndex) = Node(data);
+        return kIndex;
+      }
+
+      if (this->chunks.empty() || this->chunks.back().size() == kChunkSize)
+      {
+        // Indices of the new chunk must remain lower than kNull
+        if (this->chunks.size() >= (kNull >> kChunkBits))
+          throw std::length_error("ArenaBST capacity exceeded.");
+        this->chunks.push_back(std::vector<Node>());
+        this->chunks.back().reserve(kChunkSize);
+      }
+
+      auto& chunk = this->chunks.back();
+      chunk.push_back(Node(data));
+      return static_cast<std::uint32_t>((this->chunks.size() - 1) * kChunkSize + chunk.size() - 1);
+    }
+
+    /// Release - Push a node on the free list.
+    void Release(std::uint32_t index)
+    {
+      this->At(index).leftChild = this->freeNode;
+      this->freeNode = index;
+    }
+
+    /// AllocateSorted - Allocate the nodes of an ordered sequence as a balanced sub-tree.
+    /// Recursion depth is log(n).
+    ///
+    /// @return index of the root of the sub-tree.
+    std::uint32_t AllocateSorted(const IT& begin, const IT& end)
+    {
+      if (begin >= end)
+        return kNull;
+
+      const auto middle = begin + (std::distance(begin,end) / 2);
+      const auto kIndex = this->Allocate(*middle);
+
+      // Recursively insert both children
+      const auto kLeft = this->AllocateSorted(begin, middle);
+      const auto kRight = this->AllocateSorted(middle + 1, end);
+      this->At(kIndex).leftChild = kLeft;
+      this->At(kIndex).rightChild = kRight;
+      return kIndex;
+    }
+
+    /// FindLink - Reach the link to the first node matching the data.
+    ///
+    /// @return pointer to the link, pointing on kNull if not found.
+    std::uint32_t* FindLink(const Value& data)
+    {
+      auto* link = &this->root;
+      while (*link != kNull && !IsEqual()(this->At(*link).data, data))
+      {
+        auto& node = this->At(*link);
+        link = Compare()(data, node.data) ? &node.leftChild : &node.rightChild;
+      }
+
+      return link;
+    }
+
+    /// VisitBranchEnds - Call the functor with the depth of each node missing at least one child, using an
+    /// explicit stack (heights being computed as BST::MinHeight and BST::MaxHeight do).
+    template <typename Functor>
+    void VisitBranchEnds(Functor functor) const
+    {
+      if (this->root == kNull)
+        return;
+
+      std::vector<std::pair<std::uint32_t, std::size_t>> stack(1, std::make_pair(this->root, 1));
+      while (!stack.empty())
+      {
+        const auto kCurrent = stack.back();
+        const auto& node = this->At(kCurrent.first);
+        stack.pop_back();
+
+        if (node.leftChild == kNull || node.rightChild == kNull)
+          functor(kCurrent.second);
+        if (node.leftChild != kNull)
+          stack.push_back(std::make_pair(node.leftChild, kCurrent.second + 1));
+        if (node.rightChild != kNull)
+          stack.push_back(std::make_pair(node.rightChild, kCurrent.second + 1));
+      }
+    }
+
+    std::vector<std::vector<Node>> chunks;  // Nodes storage, chunks are never reallocated
+    std::uint32_t root;                     // Root node index, kNull if empty
+    std::uint32_t freeNode;                 // First recycled node index, kNull if none
+    std::size_t size;                       // Number of nodes within the tree
+  };
+}
+
+#endif // MODULE_DATA_STRUCTURES_ARENA_BST_HXX
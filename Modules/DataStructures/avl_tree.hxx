@@ -0,0 +1,352 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DATA_STRUCTURES_AVL_TREE_HXX
+#define MODULE_DATA_STRUCTURES_AVL_TREE_HXX
+
+// STD includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+
+namespace huc
+{
+  /// @class AVL
+  ///
+  /// An AVL Tree is a self-balancing Binary Search Tree (cf. BST): the heights of the two child sub-trees
+  /// of any node differ by at most one. Each node keeps the height of its sub-tree, and insertions and
+  /// removals restore this property on their way back to the root using at most two rotations per
+  /// visited node.
+  ///
+  /// Keys are ordered with the same rules as a BST: a key respecting the Compare operator with a node
+  /// key is inserted in its left sub-tree. As rotations move nodes from one side to the other, duplicates
+  /// may however lie on both sides of an equal key: only the in-order sequence is guaranteed to be sorted.
+  ///
+  /// @advantages
+  /// - Height is at most 1.44 * log(n): lookup, insertion and removal are O(log n) whatever the
+  ///   insertion order (sorted, streaming...).
+  /// - Recursion depth is bounded by the height: no stack overflow on large trees.
+  /// - More rigidly balanced than a Red-Black Tree: faster lookups.
+  ///
+  /// @drawbacks
+  /// - Insertions and removals are slower than on a naive BST as rotations may occur.
+  /// - Each node stores its height.
+  ///
+  /// @tparam IT type of the iterators on the sequences used to build the tree.
+  /// @tparam Compare functor type ordering the keys (e.g. less_equal).
+  /// @tparam IsEqual functor type used to identify a key.
+  template <typename IT, typename Compare, typename IsEqual>
+  class AVL
+  {
+    typedef typename std::iterator_traits<IT>::value_type Value;
+
+  public:
+    /// @class Node
+    ///
+    /// Node of an AVL tree: a key and its two sub-trees.
+    class Node
+    {
+      friend class AVL;
+
+    public:
+      Value GetData() const { return this->data; }
+      const Node* GetLeftChild() const { return this->leftChild.get(); }
+      const Node* GetRightChild() const { return this->rightChild.get(); }
+
+      /// @return height of the sub-tree rooted on this node (1 for a leaf).
+      int GetHeight() const { return this->height; }
+
+    private:
+      Node(const Value& data) : data(data), height(1) {}
+      Node(Node&) {}           // Not Implemented
+      Node operator=(Node&) {} // Not Implemented
+
+      Value data;
+      int height;
+      std::unique_ptr<Node> leftChild;
+      std::unique_ptr<Node> rightChild;
+    };
+
+    /// Build - Construct an AVL Tree given an unordered sequence of elements.
+    ///
+    /// @param begin,end - ITs to the initial and final positions of
+    /// the sequence used to build the tree. The range used is [first,last), which contains
+    /// all the elements between first and last, including the element pointed by first but
+    /// not the element pointed by last.
+    ///
+    /// @complexity O(n * log(n)).
+    ///
+    /// @return AVL Tree pointer to be owned, nullptr if construction failed.
+    static std::unique_ptr<AVL> Build(const IT& begin, const IT& end)
+    {
+      if (begin >= end)
+        return nullptr;
+
+      auto tree = std::unique_ptr<AVL>(new AVL());
+      for (auto it = begin; it != end; ++it)
+        tree->Insert(*it);
+
+      return tree;
+    }
+
+    /// Find the first node of the tree matching a specific key.
+    ///
+    /// @complexity O(log(n)).
+    ///
+    /// @param data, data value to be found within the tree.
+    ///
+    /// @return first node matching the data, nullptr if not found.
+    const Node* Find(const Value& data) const
+    {
+      auto node = this->root.get();
+      while (node && !IsEqual()(node->data, data))
+        node = Compare()(data, node->data) ? node->leftChild.get() : node->rightChild.get();
+
+      return node;
+    }
+
+    /// Insert a new key and rebalance the tree.
+    ///
+    /// @complexity O(log(n)).
+    ///
+    /// @param data data value to be added to the tree. Member type Value is the type of the
+    /// elements in the tree, defined as an alias of its first template parameter Value
+    /// (IT::Value).
+    ///
+    /// @return void.
+    void Insert(const Value& data)
+    {
+      Insert(this->root, data);
+      ++this->size;
+    }
+
+    /// Removes all elements equal [IsEqual() template parameter] to the value from the tree.
+    ///
+    /// @complexity O(k * log(n)), k being the number of elements removed.
+    ///
+    /// @param data to be removed from the tree. All elements with a value equivalent (IsEqual template
+    /// parameter) to this are removed from the container.
+    ///
+    /// @return the number of elements removed.
+    std::size_t Remove(const Value& data)
+    {
+      std::size_t count = 0;
+      while (Remove(this->root, data))
+        ++count;
+
+      this->size -= count;
+      return count;
+    }
+
+    /// Check the AVL property: for each node, the heights of both sub-trees differ by at most one and the
+    /// height stored is the one of its sub-tree.
+    ///
+    /// @complexity O(n).
+    ///
+    /// @return wheter or not the tree is balanced (true) or not (false).
+    bool IsBlanced() const
+    {
+      int height;
+      return IsBlanced(this->root.get(), height);
+    }
+
+    /// Check validity of the Binary Search Tree: the in-order sequence of keys must respect the
+    /// Compare operator.
+    ///
+    /// @complexity O(n).
+    ///
+    /// @return wheter or not the tree is a valid Binary Search Tree (true) or not (false).
+    bool IsValid() const
+    {
+      const Node* previousNode = nullptr;
+      return IsValid(this->root.get(), previousNode);
+    }
+
+    /// @complexity O(1).
+    ///
+    /// @return height of the tree, 0 if empty.
+    int GetHeight() const { return Height(this->root); }
+
+    /// @complexity O(1).
+    ///
+    /// @return number of nodes composing the tree.
+    std::size_t Size() const { return this->size; }
+
+    const Node* GetRoot() const { return this->root.get(); }
+
+  private:
+    AVL() : size(0) {}
+    AVL(AVL&) {}           // Not Implemented
+    AVL operator=(AVL&) {} // Not Implemented
+
+    static int Height(const std::unique_ptr<Node>& node) { return node ? node->height : 0; }
+
+    static void UpdateHeight(const std::unique_ptr<Node>& node)
+    { node->height = 1 + std::max(Height(node->leftChild), Height(node->rightChild)); }
+
+    /// RotateLeft - Right child becomes the root of the sub-tree.
+    static void RotateLeft(std::unique_ptr<Node>& node)
+    {
+      auto pivot = std::move(node->rightChild);
+      node->rightChild = std::move(pivot->leftChild);
+      UpdateHeight(node);
+      pivot->leftChild = std::move(node);
+      node = std::move(pivot);
+      UpdateHeight(node);
+    }
+
+    /// RotateRight - Left child becomes the root of the sub-tree.
+    static void RotateRight(std::unique_ptr<Node>& node)
+    {
+      auto pivot = std::move(node->leftChild);
+      node->leftChild = std::move(pivot->rightChild);
+      UpdateHeight(node);
+      pivot->rightChild = std::move(node);
+      node = std::move(pivot);
+      UpdateHeight(node);
+    }
+
+    /// Rebalance - Restore the AVL property of a sub-tree whose children are balanced and whose heights
+    /// differ by at most two.
+    static void Rebalance(std::unique_ptr<Node>& node)
+    {
+      const auto kBalance = Height(node->leftChild) - Height(node->rightChild);
+
+      // Left heavy - Left-Right case first brought back to the Left-Left case
+      if (kBalance > 1)
+      {
+        if (Height(node->leftChild->leftChild) < Height(node->leftChild->rightChild))
+          RotateLeft(node->leftChild);
+        RotateRight(node);
+      }
+      // Right heavy - Right-Left case first brought back to the Right-Right case
+      else if (kBalance < -1)
+      {
+        if (Height(node->rightChild->rightChild) < Height(node->rightChild->leftChild))
+          RotateRight(node->rightChild);
+        RotateLeft(node);
+      }
+      else
+        UpdateHeight(node);
+    }
+
+    static void Insert(std::unique_ptr<Node>& node, const Value& data)
+    {
+      if (!node)
+      {
+        node.reset(new Node(data));
+        return;
+      }
+
+      // Key is lower or equal than current root - Insert on the left side
+      if (Compare()(data, node->data))
+        Insert(node->leftChild, data);
+      // Key is greater than current root - Insert on the right side
+      else
+        Insert(node->rightChild, data);
+
+      Rebalance(node);
+    }
+
+    /// Remove - Remove a unique element equal to the value from the sub-tree.
+    ///
+    /// @return wheter or not an element has been removed.
+    static bool Remove(std::unique_ptr<Node>& node, const Value& data)
+    {
+      if (!node)
+        return false;
+
+      // Reach node matching the value
+      if (!IsEqual()(node->data, data))
+      {
+        if (!Remove(Compare()(data, node->data) ? node->leftChild : node->rightChild, data))
+          return false;
+      }
+      // Both children: replace the value with its successor one then remove the successor
+      else if (node->leftChild && node->rightChild)
+        node->data = RemoveMin(node->rightChild);
+      // At most one child - replace node with it
+      else
+      {
+        node.reset(node->leftChild ? node->leftChild.release() : node->rightChild.release());
+        return true;
+      }
+
+      Rebalance(node);
+      return true;
+    }
+
+    /// RemoveMin - Detach the left most node of a sub-tree.
+    ///
+    /// @return the value of the node removed.
+    static Value RemoveMin(std::unique_ptr<Node>& node)
+    {
+      if (!node->leftChild)
+      {
+        const auto kData = node->data;
+        node.reset(node->rightChild.release());
+        return kData;
+      }
+
+      const auto kData = RemoveMin(node->leftChild);
+      Rebalance(node);
+      return kData;
+    }
+
+    static bool IsBlanced(const Node* node, int& height)
+    {
+      if (!node)
+      {
+        height = 0;
+        return true;
+      }
+
+      int leftHeight, rightHeight;
+      if (!IsBlanced(node->leftChild.get(), leftHeight) || !IsBlanced(node->rightChild.get(), rightHeight))
+        return false;
+
+      height = 1 + std::max(leftHeight, rightHeight);
+      return std::abs(leftHeight - rightHeight) <= 1 && height == node->height;
+    }
+
+    static bool IsValid(const Node* node, const Node*& previousNode)
+    {
+      if (!node)
+        return true;
+
+      // Recurse on left child without breaking if not failing
+      if (!IsValid(node->leftChild.get(), previousNode))
+        return false;
+
+      // Previous data does not compare well to the current one - BST not valid
+      if (previousNode && !Compare()(previousNode->data, node->data))
+        return false;
+      previousNode = node;
+
+      return IsValid(node->rightChild.get(), previousNode);
+    }
+
+    std::unique_ptr<Node> root;  // Root node, nullptr if empty
+    std::size_t size;            // Number of nodes
+  };
+}
+
+#endif // MODULE_DATA_STRUCTURES_AVL_TREE_HXX
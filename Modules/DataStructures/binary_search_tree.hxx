@@ -20,7 +20,11 @@
 #ifndef MODULE_DATA_STRUCTURES_BST_HXX
 #define MODULE_DATA_STRUCTURES_BST_HXX
 
+// STD includes
+#include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace huc
 {
@@ -44,7 +48,9 @@ namespace huc
   /// - Use principe of binary search for insert, delete and lookup operations.
   /// - Represent well hierarchies.
   /// - Get all keys in sorted order by just doing Inorder Traversal.
-  /// - Doing order statistics, closest lower/greater elements, range queries etc. operations are easy.
+  /// - Operations are iterative: degenerated trees do not overflow the call stack.
+  /// - Doing order statistics, closest lower/greater elements, range queries etc. operations are easy:
+  ///   each node keeps the size of its sub-tree so that Rank, Select and Count are O(h).
   ///
   /// @drawbacks
   /// - The shape of the binary search tree depends entirely on the order of insertions and
@@ -56,6 +62,31 @@ namespace huc
   {
     typedef typename std::iterator_traits<IT>::value_type Value;
     public:
+      /// Destroy the sub-trees iteratively, detached nodes being destroyed without children.
+      ~BST()
+      {
+        // Leaves and detached nodes - nothing to destroy
+        if (!this->leftChild && !this->rightChild)
+          return;
+
+        std::vector<std::unique_ptr<BST>> stack;
+        auto lPushChildren = [&stack](BST& node)
+        {
+          if (node.leftChild)
+            stack.push_back(std::move(node.leftChild));
+          if (node.rightChild)
+            stack.push_back(std::move(node.rightChild));
+        };
+
+        lPushChildren(*this);
+        while (!stack.empty())
+        {
+          auto node = std::move(stack.back());
+          stack.pop_back();
+          lPushChildren(*node);
+        }
+      }
+
       /// Build - Construct in a naive way a Binary Search Tree given an unordered sequence of elements.
       ///
       /// @param begin,end - ITs to the initial and final positions of
@@ -108,6 +139,7 @@ namespace huc
         // Recursively insert both children
         root->SetLeftChild(std::move(BuildFromSorted(begin, middle)));
         root->SetRightChild(std::move(BuildFromSorted(middle + 1, end)));
+        root->size = static_cast<std::size_t>(std::distance(begin, end));
 
         return root;
       }
@@ -123,16 +155,12 @@ namespace huc
       /// @return first BST node matching the data.
       const BST* Find(const Value& data)
       {
-        // Key found returns node
-        if (IsEqual()(this->data, data))
-          return this;
-
-        // Key is less than current node - search in left subtree
-        if (Compare()(data, this->data))
-          return this->leftChild ? this->leftChild->Find(data) : nullptr;
+        // Key is less than current node - search in left subtree, otherwise in right one
+        const BST* node = this;
+        while (node && !IsEqual()(node->data, data))
+          node = Compare()(data, node->data) ? node->leftChild.get() : node->rightChild.get();
 
-        // Search in right subtree
-        return this->rightChild ? this->rightChild->Find(data) : nullptr;
+        return node;
       }
 
       /// Append a new Binary Search Tree node at the right position with current value.
@@ -146,21 +174,19 @@ namespace huc
       /// @return void.
       void Insert(const Value& data)
       {
-        // Key is lower or equal than current root - Insert on the left side
-        if (Compare()(data, this->data))
+        // Key is lower or equal than current node - Insert on the left side, otherwise on the right one
+        auto node = this;
+        while (true)
         {
-          if (!this->leftChild)
-            this->SetLeftChild(std::move(std::unique_ptr<BST>(new BST(data))));
-          else
-            this->leftChild->Insert(data);
-        }
-        // Key is greater than current root - Insert on the right side
-        else
-        {
-          if (!this->rightChild)
-            this->SetRightChild(std::move(std::unique_ptr<BST>(new BST(data))));
-          else
-            this->rightChild->Insert(data);
+          ++node->size;
+          auto& child = Compare()(data, node->data) ? node->leftChild : node->rightChild;
+          if (!child)
+          {
+            child.reset(new BST(data));
+            return;
+          }
+
+          node = child.get();
         }
       }
 
@@ -171,22 +197,38 @@ namespace huc
       bool IsBlanced() const { return this->MaxHeight() - this->MinHeight() <= 1; }
 
       /// Check validity of the Binary Search Tree.
-      /// Recursively check if subtrees do not violate any of the rules defined by a BST.
+      /// The keys of a valid BST are sorted when visited in order: each key must respect the Compare
+      /// operator with the one visited before it.
       ///
-      /// @remark Using a preordering traversal, it makes sure that:
-      /// - If the node is the left child of its parent, then it must be smaller than (or equal to)
-      ///   the parent and it must pass down the value from its parent to its right subtree to make sure none
-      ///   of the nodes in that subtree is greater than the parent.
-      /// - If the node is the right child of its parent, then it must be larger than the parent and it must
-      ///   pass down the value from its parent to its left subtree to make sure none of the nodes in that
-      ///   subtree is lesser than the parent.
+      /// @remark Using an inorder traversal with an explicit stack: the left branch of the current node is
+      /// stacked, then the nodes are popped and compared to the previous one before moving to their right
+      /// subtree.
+      ///
+      /// @complexity O(n), using O(h) memory.
       ///
       /// @return wheter or not the tree is a valid Binary Search Tree (true) or not (false).
       bool IsValid() const
       {
-        auto previousNode = std::unique_ptr<const BST*>(new const BST*);
-        *previousNode = nullptr;
-        return this->IsValid(previousNode);
+        std::vector<const BST*> stack;
+        const BST* previousNode = nullptr;
+        for (auto node = this; node || !stack.empty(); )
+        {
+          // Stack the left branch
+          for (; node; node = node->leftChild.get())
+            stack.push_back(node);
+
+          node = stack.back();
+          stack.pop_back();
+
+          // Previous data does not compare well to the current one - BST not valid
+          if (previousNode && !Compare()(previousNode->data, node->data))
+            return false;
+
+          previousNode = node;
+          node = node->rightChild.get();
+        }
+
+        return true;
       }
 
       /// Returns the biggest branch height.
@@ -196,8 +238,9 @@ namespace huc
       /// @return biggest branch height composing the tree.
       std::size_t MaxHeight() const
       {
-        return 1 + std::max(((this->leftChild) ? this->leftChild->MaxHeight() : 0),
-                            ((this->rightChild) ? this->rightChild->MaxHeight() : 0));
+        std::size_t height = 0;
+        this->Traverse([&](const BST&, std::size_t depth) { height = std::max(height, depth); });
+        return height;
       }
 
       /// Returns the smallest branch height.
@@ -207,8 +250,14 @@ namespace huc
       /// @return smallest branch height composing the tree.
       std::size_t MinHeight() const
       {
-        return 1 + std::min(((this->leftChild) ? this->leftChild->MinHeight() : 0),
-                            ((this->rightChild) ? this->rightChild->MinHeight() : 0));
+        std::size_t height = 0;
+        this->Traverse([&](const BST& node, std::size_t depth)
+        {
+          // Branch ends on nodes missing at least one child
+          if (!node.leftChild || !node.rightChild)
+            height = (height == 0) ? depth : std::min(height, depth);
+        });
+        return height;
       }
 
       /// Removes all elements equal [IsEqual() template parameter] to the value from the BST.
@@ -226,43 +275,38 @@ namespace huc
       /// @return the pointer handler by the bst passed as argument, nullptr if bst has been erased (empty).
       static const BST* Remove(std::unique_ptr<BST>& bst, const Value& data)
       {
-        // Break on empty unique_ptr
-        if (!bst)
-          return nullptr;
-
-        // Reach node matching the value
-        if (!IsEqual()(bst->data, data))
-        {
-          if (Compare()(data, bst->data))
-            Remove(bst->leftChild, data);
-          else
-            Remove(bst->rightChild, data);
-        }
-        // Proceed removal
-        else
+        // Remove matching nodes one at a time until none is left
+        for (auto* node = &FindOwner(bst, data); *node; node = &FindOwner(bst, data))
         {
-          // Recursively delete all subnodes containing the same value
-          if (bst->leftChild && IsEqual()(bst->data, bst->leftChild->data))
-            Remove(bst->leftChild, data);
+          // One node less within the sub-trees of the parents
+          for (auto parent = bst.get(); parent != node->get(); )
+          {
+            --parent->size;
+            parent = Compare()(data, parent->data) ? parent->leftChild.get() : parent->rightChild.get();
+          }
 
           // No child - Simply remove node
-          if (!bst->leftChild && !bst->rightChild)
-            bst.reset();
+          if (!(*node)->leftChild && !(*node)->rightChild)
+            node->reset();
           // Both children:
-          // - Swap node value with its predecessor
+          // - Swap node value with its predecessor (right most child of the left sub-tree)
           // - Remove predecessor node and replace it with its child
-          else if (bst->leftChild && bst->rightChild)
+          else if ((*node)->leftChild && (*node)->rightChild)
           {
-            auto& predecessor = bst->GetPredecessor();
-            std::swap(bst->data, predecessor->data);
-            predecessor.reset(predecessor->leftChild.release());
+            --(*node)->size;
+            auto* predecessor = &(*node)->leftChild;
+            for (; (*predecessor)->rightChild; predecessor = &(*predecessor)->rightChild)
+              --(*predecessor)->size;
+
+            std::swap((*node)->data, (*predecessor)->data);
+            predecessor->reset((*predecessor)->leftChild.release());
           }
           // Left node is unique child - remove node and replace it with its child.
-          else if (bst->leftChild)
-            bst.reset(bst->leftChild.release());
+          else if ((*node)->leftChild)
+            node->reset((*node)->leftChild.release());
           // Right node is unique child - remove node and replace it with its child.
-          else if (bst->rightChild)
-            bst.reset(bst->rightChild.release());
+          else
+            node->reset((*node)->rightChild.release());
         }
 
         // Return pointer handled by bst.
@@ -271,13 +315,61 @@ namespace huc
 
       /// Returns the number of nodes composing the BST.
       ///
-      /// Complexity O(n).
+      /// Complexity O(1).
       ///
       /// @return number of nodes composing the tree.
-      std::size_t Size() const
+      std::size_t Size() const { return this->size; }
+
+      /// Rank: number of elements strictly lower than the value (cf. Compare and IsEqual).
+      ///
+      /// @param data the value to be ranked.
+      ///
+      /// @complexity O(h).
+      ///
+      /// @return the number of elements preceding the value within the sorted sequence.
+      std::size_t Rank(const Value& data) const { return this->CountLower(data, false); }
+
+      /// Select the kth smallest element of the tree (with respect to the Compare operator).
+      ///
+      /// @param k the zero-based kth element - 0 for the smallest.
+      ///
+      /// @complexity O(h).
+      ///
+      /// @return the node holding the kth element, nullptr if k is out of range.
+      const BST* Select(std::size_t k) const
       {
-        return 1 + ((this->leftChild) ? this->leftChild->Size() : 0)
-                 + ((this->rightChild) ? this->rightChild->Size() : 0);
+        if (k >= this->size)
+          return nullptr;
+
+        auto node = this;
+        while (true)
+        {
+          const auto kLeftSize = node->leftChild ? node->leftChild->size : 0;
+          if (k == kLeftSize)
+            return node;
+
+          if (k < kLeftSize)
+            node = node->leftChild.get();
+          else
+          {
+            k -= kLeftSize + 1;
+            node = node->rightChild.get();
+          }
+        }
+      }
+
+      /// Count: number of elements within the range [low, high] (both bounds included).
+      ///
+      /// @param low,high bounds of the range.
+      ///
+      /// @complexity O(h).
+      ///
+      /// @return the number of elements within the range, 0 if high is lower than low.
+      std::size_t Count(const Value& low, const Value& high) const
+      {
+        const auto kUpper = this->CountLower(high, true);
+        const auto kLower = this->CountLower(low, false);
+        return (kUpper > kLower) ? kUpper - kLower : 0;
       }
 
       Value GetData() const { return this->data; }
@@ -285,79 +377,68 @@ namespace huc
       const BST* GetRightChild() const { return this->rightChild.get(); }
 
     private:
-      BST(const Value& data) : data(data) {}
+      BST(const Value& data) : data(data), size(1) {}
       BST(BST&) {}           // Not Implemented
       BST operator=(BST&) {} // Not Implemented
 
-      /// Check validity of the Binary Search Tree.
-      /// Recursively check if subtrees do not violate any of the rules defined by a BST.
+      /// Retrieve the unique_ptr reference owning the first node matching the data.
       ///
-      /// @param previousNode unique_ptr reference on const BST* used to keep track of the last node retrieved.
-      ///
-      /// @remark Using a preordering traversal, it makes sure that:
-      /// - If the node is the left child of its parent, then it must be smaller than (or equal to)
-      ///   the parent and it must pass down the value from its parent to its right subtree to make sure none
-      ///   of the nodes in that subtree is greater than the parent.
-      /// - If the node is the right child of its parent, then it must be larger than the parent and it must
-      ///   pass down the value from its parent to its left subtree to make sure none of the nodes in that
-      ///   subtree is lesser than the parent.
-      ///
-      /// @return wheter or not the tree is a valid Binary Search Tree (true) or not (false).
-      bool IsValid(std::unique_ptr<const BST*>& previousNode) const
+      /// @return the owner unique_ptr reference, empty if no node matches the data.
+      static std::unique_ptr<BST>& FindOwner(std::unique_ptr<BST>& bst, const Value& data)
       {
-        // Recurse on left child without breaking if not failing
-        if (this->leftChild &&!this->leftChild->IsValid(previousNode))
-          return false;
-
-        // First node retrieve - assign
-        if (!*previousNode)
-          *previousNode = this;
-        // Previous data does not compare well to the current one - BST not valid
-        else if (!Compare()((*previousNode)->data, this->data))
-          return false;
-
-        // Set current node
-        *previousNode = this;
+        auto* owner = &bst;
+        while (*owner && !IsEqual()((*owner)->data, data))
+          owner = Compare()(data, (*owner)->data) ? &(*owner)->leftChild : &(*owner)->rightChild;
 
-        // Recurse on right child
-        if (this->rightChild && !this->rightChild->IsValid(previousNode))
-          return false;
-
-        return true;
+        return *owner;
       }
 
-      /// Retrieve the Predecessor unique_ptr reference.
+      /// CountLower - Number of elements lower than the value using the subtree sizes.
       ///
-      /// @warning this method should not be called if no left child exists  [assert].
+      /// @param data the value to be compared with.
+      /// @param isInclusive whether or not elements equal to the value are counted.
       ///
-      /// @return the predecessor unique_ptr reference.
-      std::unique_ptr<BST>& GetPredecessor()
+      /// @remark going down from an element equal to the value to its left sub-tree remains valid as the
+      /// in-order sequence is sorted.
+      std::size_t CountLower(const Value& data, bool isInclusive) const
       {
-        // Cannot get predecessor if no left child exists
-        assert(("GetPredecessor should not be called if no left child exists.", this->leftChild));
-
-        // Left child is the predecessor
-        if (!this->leftChild->rightChild)
-          return this->leftChild;
+        std::size_t count = 0;
+        for (auto node = this; node; )
+        {
+          const bool kIsEqual = IsEqual()(node->data, data);
+          if ((kIsEqual && !isInclusive) || (!kIsEqual && Compare()(data, node->data)))
+            node = node->leftChild.get();
+          else
+          {
+            count += (node->leftChild ? node->leftChild->size : 0) + 1;
+            node = node->rightChild.get();
+          }
+        }
 
-        // Return Right Most Child
-        return this->leftChild->GetRightMostChild();
+        return count;
       }
 
-      /// Retrieve the Right Most Child unique_ptr reference.
+      /// Pre-order traversal using an explicit stack.
       ///
-      /// @warning this method should not be called if no right child exists [assert].
-      ///
-      /// @return the right most child unique_ptr reference.
-      std::unique_ptr<BST>& GetRightMostChild()
+      /// @param visit functor called with each node and its depth (1 for the root).
+      template <typename Visit>
+      void Traverse(Visit visit) const
       {
-        // Cannot get predecessor if no left child exists
-        assert(("GetRightMostChild should not be called if no right child exists.", this->rightChild));
-
-        if (this->rightChild && !this->rightChild->rightChild)
-          return this->rightChild;
+        std::vector<std::pair<const BST*, std::size_t>> stack(1, std::make_pair(this, 1));
+        while (!stack.empty())
+        {
+          auto node = stack.back().first;
+          auto depth = stack.back().second;
+          stack.pop_back();
 
-        return this->rightChild->GetRightMostChild();
+          // Walk down the left branch, stacking right children only
+          for (; node; node = node->leftChild.get(), ++depth)
+          {
+            visit(*node, depth);
+            if (node->rightChild)
+              stack.push_back(std::make_pair(node->rightChild.get(), depth + 1));
+          }
+        }
       }
 
       void SetLeftChild(std::unique_ptr<BST> bst) { this->leftChild = std::move(bst); }
@@ -366,6 +447,7 @@ namespace huc
       typename std::iterator_traits<IT>::value_type data;
       std::unique_ptr<BST> leftChild;
       std::unique_ptr<BST> rightChild;
+      std::size_t size;
   };
 }
 
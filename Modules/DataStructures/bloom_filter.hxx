@@ -0,0 +1,178 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_DATA_STRUCTURES_BLOOM_FILTER_HXX
+#define MODULE_DATA_STRUCTURES_BLOOM_FILTER_HXX
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace huc
+{
+  /// @class BloomFilter
+  ///
+  /// A Bloom Filter is a probabilistic set answering whether a key may have been inserted: a key inserted
+  /// is always found, a key not inserted is found with a small probability (false positive).
+  ///
+  /// This is a blocked (split block) version: each key is mapped on a unique block of 8 words of 32 bits
+  /// and sets one bit within each word of the block. Blocks are 32 bytes aligned so that a probe touches a
+  /// single cache line, and the 8 bit positions are computed using 8 multiplications by constant salts,
+  /// a fixed length loop compilers turn into vector instructions.
+  ///
+  /// @advantages
+  /// - A single cache miss per insertion or probe, whatever the number of bits per key.
+  /// - Compact: about 1% of false positives using 10 bits per key.
+  /// - Batched probes (cf. Filter) prefetch the blocks of several keys before testing them.
+  ///
+  /// @drawbacks
+  /// - Keys cannot be removed.
+  /// - Slightly more false positives than a standard Bloom Filter using the same memory.
+  ///
+  /// @tparam T type of the keys.
+  /// @tparam Hash functor type used to hash the keys.
+  template <typename T, typename Hash = std::hash<T>>
+  class BloomFilter
+  {
+    static const std::size_t kBlockWords = 8;  // Words per block (32 bytes)
+    static const int kBatchSize = 16;          // Keys probed at once by Filter
+
+  public:
+    /// @param size expected number of keys.
+    /// @param bitsPerKey number of bits to be used per key (the more, the less false positives).
+    explicit BloomFilter(std::size_t size, double bitsPerKey = 10) :
+      blocks(std::max<std::size_t>(1, static_cast<std::size_t>(
+        std::ceil(static_cast<double>(size) * bitsPerKey / (32 * kBlockWords))))),
+      words(blocks * kBlockWords + kBlockWords - 1, 0)
+    {
+      // First word aligned on the block size
+      const auto kAddress = reinterpret_cast<std::uintptr_t>(this->words.data());
+      const std::size_t kBlockBytes = kBlockWords * sizeof(std::uint32_t);
+      this->offset = ((kBlockBytes - kAddress % kBlockBytes) % kBlockBytes) / sizeof(std::uint32_t);
+    }
+
+    /// Insert a key.
+    ///
+    /// @complexity O(1).
+    void Insert(const T& key)
+    {
+      const auto kHash = Mix(key);
+      auto* block = this->Block(kHash);
+      for (std::size_t i = 0; i < kBlockWords; ++i)
+        block[i] |= Bit(kHash, i);
+    }
+
+    /// Insert the keys of a sequence.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of the sequence.
+    template <typename IT>
+    void Insert(const IT& begin, const IT& end)
+    {
+      for (auto it = begin; it != end; ++it)
+        this->Insert(*it);
+    }
+
+    /// @complexity O(1).
+    ///
+    /// @return false if the key has not been inserted, true if it may have been.
+    bool MayContain(const T& key) const { return this->MayContainHash(Mix(key)); }
+
+    /// Filter - Batched probes: copy the keys of a sequence that may have been inserted.
+    ///
+    /// @param begin,end - iterators to the initial and final positions of the sequence.
+    /// @param output iterator to the initial position of the destination sequence.
+    ///
+    /// @complexity O(n), the blocks of kBatchSize keys being prefetched before being probed.
+    ///
+    /// @return iterator to the end of the destination sequence.
+    template <typename IT, typename OutputIT>
+    OutputIT Filter(const IT& begin, const IT& end, OutputIT output) const
+    {
+      std::uint64_t hashes[kBatchSize];
+      for (auto it = begin; it != end; )
+      {
+        // Hash the keys of the batch and prefetch their blocks
+        const auto kBatchBegin = it;
+        int count = 0;
+        for (; it != end && count < kBatchSize; ++it, ++count)
+        {
+          hashes[count] = Mix(*it);
+#if defined(__GNUC__) || defined(__clang__)
+          __builtin_prefetch(this->Block(hashes[count]));
+#endif
+        }
+
+        // Probe them
+        auto key = kBatchBegin;
+        for (int i = 0; i < count; ++i, ++key)
+          if (this->MayContainHash(hashes[i]))
+            *output++ = *key;
+      }
+
+      return output;
+    }
+
+    /// @return the number of blocks of the filter.
+    std::size_t GetBlockCount() const { return this->blocks; }
+
+    /// @return the memory used by the bits of the filter in bytes.
+    std::size_t GetMemorySize() const { return this->blocks * kBlockWords * sizeof(std::uint32_t); }
+
+  private:
+    BloomFilter(BloomFilter&) {}           // Not Implemented: a copy would lose the block alignment
+    BloomFilter operator=(BloomFilter&) {} // Not Implemented
+
+    /// Hash a key on 64 bits: highest bits select the block, lowest ones the bits within the block.
+    static std::uint64_t Mix(const T& key)
+    { return static_cast<std::uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ull; }
+
+    /// Bit of the word i of the block set by the key hash.
+    static std::uint32_t Bit(std::uint64_t hash, std::size_t i)
+    {
+      static const std::uint32_t kSalts[kBlockWords] = {0x47B6137Bu, 0x44974D91u, 0x8824AD5Bu, 0xA2B7289Du,
+                                                        0x705495C7u, 0x2DF1424Bu, 0x9EFC4947u, 0x5C6BFB31u};
+      return 1u << ((static_cast<std::uint32_t>(hash) * kSalts[i]) >> 27);
+    }
+
+    bool MayContainHash(std::uint64_t hash) const
+    {
+      const auto* block = this->Block(hash);
+      std::uint32_t missing = 0;
+      for (std::size_t i = 0; i < kBlockWords; ++i)
+        missing |= Bit(hash, i) & ~block[i];
+      return missing == 0;
+    }
+
+    /// Block of the key hash: multiply-shift of its highest bits on the number of blocks.
+    const std::uint32_t* Block(std::uint64_t hash) const
+    { return this->words.data() + this->offset + ((hash >> 32) * this->blocks >> 32) * kBlockWords; }
+    std::uint32_t* Block(std::uint64_t hash)
+    { return this->words.data() + this->offset + ((hash >> 32) * this->blocks >> 32) * kBlockWords; }
+
+    std::size_t blocks;                // Number of blocks
+    std::vector<std::uint32_t> words;  // Blocks words, starting from the offset
+    std::size_t offset;                // First word aligned on the block size
+  };
+}
+
+#endif // MODULE_DATA_STRUCTURES_BLOOM_FILTER_HXX
@@ -0,0 +1,143 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <intro_select.hxx>
+
+// STD includes
+#include <functional>
+#include <random>
+
+using namespace huc::search;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  const int SortedArrayInt[] = {-3, -2, 0, 2, 8, 15, 36, 212, 366};  // Simple sorted array of integers
+  const int RandomArrayInt[] = {4, 3, 5, 2, -18, 3, 2, 3, 4, 5, -5}; // Simple random array of integers
+  const std::string RandomStr = "xacvgeze";                          // Random string
+
+  typedef std::vector<int> Container;
+  typedef Container::iterator IT;
+  typedef std::greater_equal<Container::value_type> GR_Compare;
+
+  // Check the kth element and the partition of the sequence around it
+  void CheckSelection(Container sequence, unsigned int k)
+  {
+    Container sorted = sequence;
+    std::sort(sorted.begin(), sorted.end());
+
+    auto kth = IntroSelect<IT>(sequence.begin(), sequence.end(), k);
+    ASSERT_EQ(sequence.begin() + k, kth);
+    EXPECT_EQ(sorted[k], *kth);
+    for (auto it = sequence.begin(); it < kth; ++it)
+      EXPECT_LE(*it, *kth);
+    for (auto it = kth; it < sequence.end(); ++it)
+      EXPECT_GE(*it, *kth);
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test kth smallest elements
+TEST(TestSearch, IntroSelect)
+{
+  {
+    // Basic run on random array - Should return 4
+    Container krandomdArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    EXPECT_EQ(4, *IntroSelect<IT>(krandomdArray.begin(), krandomdArray.end(), 7));
+  }
+
+  Container ksortedArray(SortedArrayInt, SortedArrayInt + sizeof(SortedArrayInt) / sizeof(int));
+
+  // Basic run on sorted array with unique element - Should the kth element
+  EXPECT_EQ(ksortedArray.begin() + 4, IntroSelect<IT>(ksortedArray.begin(), ksortedArray.end(), 4));
+
+  // Empty sequence - Should return end on empty sequence
+  EXPECT_EQ(ksortedArray.begin(), IntroSelect<IT>(ksortedArray.begin(), ksortedArray.begin(), 0));
+
+  // Unique element sequence - Should return the unique element
+  EXPECT_EQ(ksortedArray.begin(), IntroSelect<IT>(ksortedArray.begin(), ksortedArray.begin() + 1, 0));
+
+  // k bigger than the size of the sequence - Should return end for out of scope search
+  EXPECT_EQ(ksortedArray.end(), IntroSelect<IT>(ksortedArray.begin(), ksortedArray.end(), 100));
+
+  // Biggest element - Should return 5 (second biggest value)
+  {
+    Container krandomdArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    const auto kth = IntroSelect<IT, GR_Compare>(krandomdArray.begin(), krandomdArray.end(), 1);
+    EXPECT_EQ(5, *kth);
+  }
+
+  // String
+  {
+    std::string randomStr = RandomStr;
+    EXPECT_EQ('c', *IntroSelect<std::string::iterator>(randomStr.begin(), randomStr.end(), 1));
+  }
+}
+
+// Test selection on large sequences and adversarial patterns
+TEST(TestSearch, IntroSelectLargeSequences)
+{
+  const int kSize = 10007;
+  std::mt19937 generator(42);
+  Container random(kSize), fewUniques(kSize), sorted(kSize), inversed(kSize), organPipe(kSize);
+  for (int i = 0; i < kSize; ++i)
+  {
+    random[i] = static_cast<int>(generator());
+    fewUniques[i] = static_cast<int>(generator() % 4);
+    sorted[i] = i;
+    inversed[i] = kSize - i;
+    organPipe[i] = (i < kSize / 2) ? i : kSize - i;
+  }
+
+  const unsigned int kRanks[] = {0, 1, kSize / 10, kSize / 2, kSize - 100, kSize - 1};
+  for (auto rank = std::begin(kRanks); rank != std::end(kRanks); ++rank)
+  {
+    CheckSelection(random, *rank);
+    CheckSelection(fewUniques, *rank);
+    CheckSelection(sorted, *rank);
+    CheckSelection(inversed, *rank);
+    CheckSelection(organPipe, *rank);
+    CheckSelection(Container(kSize, 7), *rank);
+  }
+}
+
+// Test median of medians pivot quality
+TEST(TestSearch, MedianOfMedians)
+{
+  // Empty sequence - Should return end
+  {
+    Container emptyArray;
+    EXPECT_EQ(emptyArray.end(), MedianOfMedians<IT>(emptyArray.begin(), emptyArray.end()));
+  }
+
+  // Pivot should be greater and smaller than at least 30% of the elements
+  {
+    const int kSize = 1000;
+    std::mt19937 generator(7);
+    Container sequence(kSize);
+    for (auto it = sequence.begin(); it != sequence.end(); ++it)
+      *it = static_cast<int>(generator() % 10000);
+
+    const auto pivotValue = *MedianOfMedians<IT>(sequence.begin(), sequence.end());
+    const auto lower = std::count_if(sequence.begin(), sequence.end(),
+                                     [pivotValue](int val) { return val <= pivotValue; });
+    EXPECT_LE(3 * kSize / 10, lower);
+    EXPECT_GE(7 * kSize / 10, lower);
+  }
+}
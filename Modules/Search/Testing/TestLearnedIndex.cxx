@@ -0,0 +1,140 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <learned_index.hxx>
+
+// STD includes
+#include <cstdint>
+#include <random>
+
+// Testing namespace
+using namespace huc::search;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Simple sorted array of integers with negative values
+  const int SortedArrayInt[] = {-3, -2, 0, 2, 8, 15, 36, 212, 366};
+  // Simple sorted array of floats with negative values
+  const double SortedDoubleArray[] = {-.3, 0.0, 0.12, 2.5, 8};
+
+  typedef std::vector<int> Container;
+  typedef Container::const_iterator Const_IT;
+  typedef std::vector<uint64_t>::const_iterator Const_IT_U64;
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test LearnedIndex construction
+TEST(TestSearch, LearnedIndexBuild)
+{
+  // Empty Array - No index should be built
+  {
+    const Container kEmptyCollection = Container();
+    EXPECT_FALSE(LearnedIndex<Const_IT>::Build(kEmptyCollection.begin(), kEmptyCollection.end()));
+  }
+
+  // Null epsilon - No index should be built
+  {
+    const Container kSortedArray(SortedArrayInt, SortedArrayInt + sizeof(SortedArrayInt) / sizeof(int));
+    EXPECT_FALSE(LearnedIndex<Const_IT>::Build(kSortedArray.begin(), kSortedArray.end(), 0));
+  }
+
+  // Linear keys - Should be modeled by a unique segment
+  {
+    Container linearArray;
+    for (int i = 0; i < 1000; ++i)
+      linearArray.push_back(3 * i - 100);
+    auto index = LearnedIndex<Const_IT>::Build(linearArray.begin(), linearArray.end(), 1);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(1u, index->GetSegmentCount());
+    EXPECT_EQ(1u, index->GetHeight());
+  }
+}
+
+// Test LearnedIndex lookups on small sequences
+TEST(TestSearch, LearnedIndexFind)
+{
+  // Each element should be found at its position - not others
+  {
+    const Container kSortedArray(SortedArrayInt, SortedArrayInt + sizeof(SortedArrayInt) / sizeof(int));
+    auto index = LearnedIndex<Const_IT>::Build(kSortedArray.begin(), kSortedArray.end(), 1);
+    ASSERT_TRUE(index);
+    for (std::size_t i = 0; i < kSortedArray.size(); ++i)
+      EXPECT_EQ(static_cast<int>(i), index->Find(kSortedArray[i]));
+    EXPECT_EQ(-1, index->Find(-4));
+    EXPECT_EQ(-1, index->Find(1));
+    EXPECT_EQ(-1, index->Find(400));
+  }
+
+  // Doubles
+  {
+    const std::vector<double> kSortedDoubleArray
+      (SortedDoubleArray, SortedDoubleArray + sizeof(SortedDoubleArray) / sizeof(double));
+    auto index = LearnedIndex<std::vector<double>::const_iterator>::Build
+      (kSortedDoubleArray.begin(), kSortedDoubleArray.end(), 1);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(2, index->Find(0.12));
+    EXPECT_EQ(-1, index->Find(8.1));
+  }
+
+  // Identical values - Should be found within the sequence
+  {
+    const Container kIdenticalArray(100, 3);
+    auto index = LearnedIndex<Const_IT>::Build(kIdenticalArray.begin(), kIdenticalArray.end(), 4);
+    ASSERT_TRUE(index);
+    EXPECT_LE(0, index->Find(3));
+    EXPECT_EQ(-1, index->Find(4));
+  }
+}
+
+// Test LearnedIndex against BinarySearch on large sequence of 64 bits keys
+TEST(TestSearch, LearnedIndexLargeKeys)
+{
+  std::mt19937_64 generator(42);
+  std::vector<uint64_t> keys(100000);
+  for (auto it = keys.begin(); it != keys.end(); ++it)
+    *it = generator() >> (it - keys.begin()) % 40; // Mixed magnitudes, full 64 bits range
+  std::sort(keys.begin(), keys.end());
+
+  for (unsigned int epsilon = 4; epsilon <= 256; epsilon *= 8)
+  {
+    auto index = LearnedIndex<Const_IT_U64>::Build(keys.begin(), keys.end(), epsilon);
+    ASSERT_TRUE(index);
+    EXPECT_LT(index->GetSegmentCount(), keys.size());
+    EXPECT_LT(index->GetModelSize(), keys.size() * sizeof(uint64_t));
+
+    // Existing keys should be found as by a plain binary search
+    for (std::size_t i = 0; i < keys.size(); i += 7)
+    {
+      const auto found = index->Find(keys[i]);
+      ASSERT_LE(0, found);
+      EXPECT_EQ(keys[i], keys[found]);
+    }
+
+    // Non existing keys should not be found
+    for (std::size_t i = 1; i < keys.size(); i += 11)
+    {
+      if (keys[i] - keys[i - 1] > 1)
+      {
+        EXPECT_EQ(-1, index->Find(keys[i] - 1));
+      }
+    }
+    EXPECT_EQ(-1, index->Find(std::numeric_limits<uint64_t>::max()));
+  }
+}
@@ -22,6 +22,7 @@
 
 // STD includes
 #include <functional>
+#include <random>
 
 // Testing namespace
 using namespace huc::search;
@@ -88,3 +89,134 @@ TEST(TestSearch, MaxDistances)
     EXPECT_EQ(6, indexes.second);
   }
 }
+
+// Test MaxDistanceStream against MaxDistance on the values pushed
+TEST(TestSearch, MaxDistanceStream)
+{
+  // Should return <-1,-1> while less than two values were pushed
+  {
+    MaxDistanceStream<int> stream;
+    EXPECT_EQ(-1, stream.Best().first);
+    stream.Push(2);
+    EXPECT_EQ(-1, stream.Best().second);
+    EXPECT_EQ(1, stream.Count());
+  }
+
+  // Should return <4,9> (largest benefice of 23), same indexes as MaxDistance after each push
+  {
+    Container marketPrices(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    MaxDistanceStream<int> stream;
+    for (auto it = marketPrices.begin(); it != marketPrices.end(); ++it)
+    {
+      stream.Push(*it);
+      const auto kIndexes = MaxDistance<IT>(marketPrices.begin(), it + 1);
+      EXPECT_EQ(kIndexes.first, stream.Best().first);
+      EXPECT_EQ(kIndexes.second, stream.Best().second);
+    }
+    EXPECT_EQ(4, stream.Best().first);
+    EXPECT_EQ(9, stream.Best().second);
+    EXPECT_EQ(23, stream.BestDistance());
+  }
+
+  // Batches of random values
+  {
+    std::mt19937 generator(42);
+    Container values(10000);
+    for (auto it = values.begin(); it != values.end(); ++it)
+      *it = static_cast<int>(generator() % 1000);
+
+    MaxDistanceStream<int> stream;
+    for (auto it = values.begin(); it != values.end(); )
+    {
+      const auto kNext = it + std::min<std::ptrdiff_t>(1 + generator() % 700, values.end() - it);
+      stream.Push(it, kNext);
+      it = kNext;
+
+      const auto kIndexes = MaxDistance<IT>(values.begin(), it);
+      EXPECT_EQ(kIndexes.first, stream.Best().first);
+      EXPECT_EQ(kIndexes.second, stream.Best().second);
+    }
+    EXPECT_EQ(static_cast<long long>(values.size()), stream.Count());
+  }
+}
+
+// Test MaxDistanceWindow against MaxDistance on the last values pushed
+TEST(TestSearch, MaxDistanceWindow)
+{
+  // Should return <-1,-1> while less than two values were pushed
+  {
+    MaxDistanceWindow<int> window(4);
+    EXPECT_EQ(-1, window.Best().first);
+    window.Push(2);
+    EXPECT_EQ(-1, window.Best().second);
+  }
+
+  // Random, sorted, decreasing and constant values, several window sizes
+  std::mt19937 generator(7);
+  std::vector<Container> sequences(4, Container(2000));
+  for (int i = 0; i < 2000; ++i)
+  {
+    sequences[0][i] = static_cast<int>(generator() % 50);
+    sequences[1][i] = i / 3;
+    sequences[2][i] = -i / 3;
+    sequences[3][i] = 5;
+  }
+
+  const std::size_t kWindows[] = {2, 3, 17, 256};
+  for (auto sequence = sequences.begin(); sequence != sequences.end(); ++sequence)
+    for (auto kWindow = std::begin(kWindows); kWindow != std::end(kWindows); ++kWindow)
+    {
+      MaxDistanceWindow<int> window(*kWindow);
+      for (auto it = sequence->begin(); it != sequence->end(); ++it)
+      {
+        window.Push(*it);
+
+        const auto kFirst = it + 1 - static_cast<std::ptrdiff_t>(window.Size());
+        const auto kOffset = static_cast<long long>(std::distance(sequence->begin(), kFirst));
+        const auto kIndexes = MaxDistance<IT>(kFirst, it + 1);
+        EXPECT_EQ(kIndexes.first < 0 ? -1 : kIndexes.first + kOffset, window.Best().first);
+        EXPECT_EQ(kIndexes.second < 0 ? -1 : kIndexes.second + kOffset, window.Best().second);
+      }
+      EXPECT_EQ(*kWindow, window.Size());
+    }
+}
+
+// Test ParallelMaxDistance against MaxDistance
+TEST(TestSearch, ParallelMaxDistance)
+{
+  // Should return <-1,-1> on insufficient array and <4,9> on the simple market array
+  {
+    Container insufficientArray = Container(1, 2);
+    const auto kIndexes = ParallelMaxDistance<IT>(insufficientArray.begin(), insufficientArray.end(), 4);
+    EXPECT_EQ(-1, kIndexes.first);
+    EXPECT_EQ(-1, kIndexes.second);
+
+    Container marketPrices(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    EXPECT_EQ(std::make_pair(4, 9), ParallelMaxDistance<IT>(marketPrices.begin(), marketPrices.end(), 4));
+  }
+
+  // Large sequences - Random walks of ints and doubles, decreasing and constant values
+  {
+    std::mt19937 generator(42);
+    const int kSize = 100003;
+    std::vector<Container> sequences(4, Container(kSize));
+    std::vector<double> walk(kSize);
+    for (int i = 0; i < kSize; ++i)
+    {
+      sequences[0][i] = static_cast<int>(generator() % 1000);
+      sequences[1][i] = (i > 0 ? sequences[1][i - 1] : 0) + static_cast<int>(generator() % 21) - 10;
+      sequences[2][i] = -i / 7;
+      sequences[3][i] = 5;
+      walk[i] = (i > 0 ? walk[i - 1] : 0.) + static_cast<double>(generator() % 2001) / 1000. - 1.;
+    }
+
+    for (auto it = sequences.begin(); it != sequences.end(); ++it)
+      for (unsigned int threads = 2; threads <= 8; threads += 3)
+        EXPECT_EQ(MaxDistance<IT>(it->begin(), it->end()),
+                  ParallelMaxDistance<IT>(it->begin(), it->end(), threads));
+
+    typedef std::vector<double>::const_iterator D_IT;
+    EXPECT_EQ(MaxDistance<D_IT>(walk.begin(), walk.end()),
+              ParallelMaxDistance<D_IT>(walk.begin(), walk.end(), 5));
+  }
+}
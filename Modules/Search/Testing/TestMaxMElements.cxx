@@ -20,6 +20,9 @@
 #include <gtest/gtest.h>
 #include <max_m_elements.hxx>
 
+// STD includes
+#include <random>
+
 using namespace huc::search;
 
 #ifndef DOXYGEN_SKIP
@@ -111,3 +114,69 @@ TEST(TestSearch, MaxNElementsLowestValues)
     EXPECT_EQ(2, kMaxElements[3]);
   }
 }
+
+// Test MaxMElementsHeap and ParallelMaxMElements against MaxMElements
+TEST(TestSearch, MaxMElementsHeap)
+{
+  // Should return empty vector on insufficient vector or when looking for less than 1 elements
+  {
+    Container uniqueEl = Container(1, 2);
+    EXPECT_TRUE((MaxMElementsHeap<Container, IT>(uniqueEl.begin(), uniqueEl.end(), 2).empty()));
+    EXPECT_TRUE((MaxMElementsHeap<Container, IT>(uniqueEl.begin(), uniqueEl.end(), 0).empty()));
+    EXPECT_TRUE((ParallelMaxMElements<Container, IT>(uniqueEl.begin(), uniqueEl.end(), 2).empty()));
+  }
+
+  // Small sequences - Should return the same elements in the same order
+  for (int m = 1; m <= static_cast<int>(sizeof(RandomArrayInt) / sizeof(int)); ++m)
+  {
+    Container kRandomElements(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    EXPECT_EQ((MaxMElements<Container, IT>(kRandomElements.begin(), kRandomElements.end(), m)),
+              (MaxMElementsHeap<Container, IT>(kRandomElements.begin(), kRandomElements.end(), m)));
+    EXPECT_EQ((MaxMElements<Container, IT, std::less_equal<int>>
+                (kRandomElements.begin(), kRandomElements.end(), m)),
+              (MaxMElementsHeap<Container, IT, std::less_equal<int>>
+                (kRandomElements.begin(), kRandomElements.end(), m)));
+  }
+
+  // Large sequences - ints with duplicates and doubles, all comparators
+  {
+    std::mt19937 generator(42);
+    Container randomInts(50000);
+    std::vector<double> randomDoubles(50000);
+    for (std::size_t i = 0; i < randomInts.size(); ++i)
+    {
+      randomInts[i] = static_cast<int>(generator() % 20000) - 10000;
+      randomDoubles[i] = static_cast<double>(generator()) / 7.;
+    }
+
+    typedef std::vector<double> DContainer;
+    typedef DContainer::const_iterator D_IT;
+    const int kMs[] = {1, 17, 500};
+    for (auto m = std::begin(kMs); m != std::end(kMs); ++m)
+    {
+      const auto kMaxInts = MaxMElements<Container, IT>(randomInts.begin(), randomInts.end(), *m);
+      EXPECT_EQ(kMaxInts, (MaxMElementsHeap<Container, IT>(randomInts.begin(), randomInts.end(), *m)));
+      EXPECT_EQ(kMaxInts, (ParallelMaxMElements<Container, IT>(randomInts.begin(), randomInts.end(), *m, 3)));
+
+      const auto kMinInts =
+        MaxMElements<Container, IT, std::less<int>>(randomInts.begin(), randomInts.end(), *m);
+      EXPECT_EQ(kMinInts, (MaxMElementsHeap<Container, IT, std::less<int>>
+                            (randomInts.begin(), randomInts.end(), *m)));
+      EXPECT_EQ(kMinInts, (ParallelMaxMElements<Container, IT, std::less<int>>
+                            (randomInts.begin(), randomInts.end(), *m, 4)));
+
+      const auto kMaxDoubles = MaxMElements<DContainer, D_IT>(randomDoubles.begin(), randomDoubles.end(), *m);
+      EXPECT_EQ(kMaxDoubles, (MaxMElementsHeap<DContainer, D_IT>
+                               (randomDoubles.begin(), randomDoubles.end(), *m)));
+      EXPECT_EQ(kMaxDoubles, (ParallelMaxMElements<DContainer, D_IT>
+                               (randomDoubles.begin(), randomDoubles.end(), *m, 2)));
+    }
+  }
+
+  // String - Should return the biggest letters
+  {
+    const std::string kRandomStr = "xacvgeze";
+    EXPECT_EQ("zxv", (MaxMElementsHeap<std::string, std::string::const_iterator>
+                       (kRandomStr.begin(), kRandomStr.end(), 3)));
+  }
+}
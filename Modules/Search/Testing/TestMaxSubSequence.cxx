@@ -22,6 +22,7 @@
 
 // STD includes
 #include <functional>
+#include <random>
 
 // Testing namespace
 using namespace huc::search;
@@ -82,3 +83,66 @@ TEST(TestSearch, MaxSubSequence)
     EXPECT_EQ(kSize - 1, indexes.second);
   }
 }
+
+// Test ParallelMaxSubSequence against MaxSubSequence
+TEST(TestSearch, ParallelMaxSubSequence)
+{
+  // Should return <-1,-1> on insufficient array and the sequential indexes on small arrays
+  {
+    Container insufficientArray = Container(1, 2);
+    const auto kIndexes = ParallelMaxSubSequence<IT>(insufficientArray.begin(), insufficientArray.end(), 4);
+    EXPECT_EQ(-1, kIndexes.first);
+    EXPECT_EQ(-1, kIndexes.second);
+
+    Container kMarketPrices(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    EXPECT_EQ(MaxSubSequence<IT>(kMarketPrices.begin(), kMarketPrices.end()),
+              ParallelMaxSubSequence<IT>(kMarketPrices.begin(), kMarketPrices.end(), 4));
+  }
+
+  // Large sequences - Random gains/losses, with a drift, only losses and constant values
+  {
+    std::mt19937 generator(42);
+    const int kSize = 100003;
+    std::vector<Container> sequences(5, Container(kSize));
+    for (int i = 0; i < kSize; ++i)
+    {
+      sequences[0][i] = static_cast<int>(generator() % 2001) - 1000;
+      sequences[1][i] = static_cast<int>(generator() % 2001) - 990;
+      sequences[2][i] = static_cast<int>(generator() % 2001) - 1010;
+      sequences[3][i] = -static_cast<int>(generator() % 100) - 1;
+      sequences[4][i] = 0;
+    }
+
+    for (auto it = sequences.begin(); it != sequences.end(); ++it)
+      for (unsigned int threads = 2; threads <= 8; threads += 3)
+      {
+        EXPECT_EQ(MaxSubSequence<IT>(it->begin(), it->end()),
+                  ParallelMaxSubSequence<IT>(it->begin(), it->end(), threads));
+        EXPECT_EQ((MaxSubSequence<IT, std::minus<int>, std::less<int>>(it->begin(), it->end())),
+                  (ParallelMaxSubSequence<IT, std::minus<int>, std::less<int>>
+                    (it->begin(), it->end(), threads)));
+      }
+  }
+
+  // Summaries combination should be associative
+  {
+    std::mt19937 generator(7);
+    Container values(64);
+    for (auto it = values.begin(); it != values.end(); ++it)
+      *it = static_cast<int>(generator() % 21) - 10;
+
+    const auto kA = SubSequenceScan<IT>(values.begin(), values.begin(), values.begin() + 20);
+    const auto kB = SubSequenceScan<IT>(values.begin(), values.begin() + 20, values.begin() + 41);
+    const auto kC = SubSequenceScan<IT>(values.begin(), values.begin() + 41, values.end());
+    const auto kLeft = CombineSubSequence(CombineSubSequence(kA, kB), kC);
+    const auto kRight = CombineSubSequence(kA, CombineSubSequence(kB, kC));
+    const auto kWhole = SubSequenceScan<IT>(values.begin(), values.begin(), values.end());
+    EXPECT_EQ(kWhole.total, kLeft.total);
+    EXPECT_EQ(kWhole.best, kLeft.best);
+    EXPECT_EQ(kLeft.best, kRight.best);
+    EXPECT_EQ(kLeft.first, kRight.first);
+    EXPECT_EQ(kLeft.second, kRight.second);
+    EXPECT_EQ(kWhole.first, kRight.first);
+    EXPECT_EQ(kWhole.second, kRight.second);
+  }
+}
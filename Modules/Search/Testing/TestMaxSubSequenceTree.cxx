@@ -0,0 +1,127 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <max_sub_sequence_tree.hxx>
+
+// STD includes
+#include <random>
+
+// Testing namespace
+using namespace huc::search;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  // Simple random array of integers with negative values
+  const int RandomArrayInt[] = {4, 3, 5, 2, -18, 3, 2, 3, 4, 5, -5};
+
+  typedef std::vector<int> Container;
+  typedef Container::iterator IT;
+  typedef MaxSubSequenceTree<int> Tree;
+
+  // Reference result of MaxSubSequence on the range [first, last] of the sequence
+  std::pair<int, int> MaxSubSequenceRange(Container& values, std::size_t first, std::size_t last)
+  {
+    auto indexes = MaxSubSequence<IT>(values.begin() + first, values.begin() + last + 1);
+    if (indexes.first >= 0)
+    {
+      indexes.first += static_cast<int>(first);
+      indexes.second += static_cast<int>(first);
+    }
+    return indexes;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test MaxSubSequenceTree construction and queries
+TEST(TestSearch, MaxSubSequenceTree)
+{
+  // Should return nullptr on empty sequence and <-1,-1> on invalid ranges
+  {
+    Container emptyArray;
+    EXPECT_EQ(nullptr, Tree::Build(emptyArray.begin(), emptyArray.end()));
+
+    Container kMarketPrices(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    const auto kTree = Tree::Build(kMarketPrices.begin(), kMarketPrices.end());
+    EXPECT_EQ(kMarketPrices.size(), kTree->Size());
+    EXPECT_EQ(std::make_pair(-1, -1), kTree->Query(3, 3));
+    EXPECT_EQ(std::make_pair(-1, -1), kTree->Query(4, 2));
+    EXPECT_EQ(std::make_pair(-1, -1), kTree->Query(0, kMarketPrices.size()));
+    EXPECT_FALSE(Tree::Build(kMarketPrices.begin(), kMarketPrices.end())->Update(kMarketPrices.size(), 0));
+  }
+
+  // Should return <5,9> on the whole sequence and the MaxSubSequence indexes on any range
+  {
+    Container kMarketPrices(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    const auto kTree = Tree::Build(kMarketPrices.begin(), kMarketPrices.end());
+    EXPECT_EQ(std::make_pair(5, 9), kTree->Query(0, kMarketPrices.size() - 1));
+    for (std::size_t first = 0; first < kMarketPrices.size(); ++first)
+      for (std::size_t last = first + 1; last < kMarketPrices.size(); ++last)
+        EXPECT_EQ(MaxSubSequenceRange(kMarketPrices, first, last), kTree->Query(first, last));
+  }
+
+  // Random sequences and ranges, including minimum sub sequences
+  {
+    std::mt19937 generator(42);
+    Container values(1001);
+    for (auto it = values.begin(); it != values.end(); ++it)
+      *it = static_cast<int>(generator() % 201) - 100;
+
+    const auto kTree = Tree::Build(values.begin(), values.end());
+    const auto kMinTree = MaxSubSequenceTree<int, std::minus<int>, std::less<int>>::Build(values.begin(),
+                                                                                          values.end());
+    for (int i = 0; i < 2000; ++i)
+    {
+      const std::size_t kFirst = generator() % values.size();
+      const std::size_t kLast = kFirst + generator() % (values.size() - kFirst);
+      if (kFirst == kLast)
+        continue;
+
+      EXPECT_EQ(MaxSubSequenceRange(values, kFirst, kLast), kTree->Query(kFirst, kLast));
+      const auto kMinIndexes = MaxSubSequence<IT, std::minus<int>, std::less<int>>(values.begin() + kFirst,
+                                                                            values.begin() + kLast + 1);
+      EXPECT_EQ(kMinIndexes.first + static_cast<int>(kFirst), kMinTree->Query(kFirst, kLast).first);
+      EXPECT_EQ(kMinIndexes.second + static_cast<int>(kFirst), kMinTree->Query(kFirst, kLast).second);
+    }
+  }
+}
+
+// Test MaxSubSequenceTree updates
+TEST(TestSearch, MaxSubSequenceTreeUpdate)
+{
+  std::mt19937 generator(7);
+  Container values(257);
+  for (auto it = values.begin(); it != values.end(); ++it)
+    *it = static_cast<int>(generator() % 21) - 10;
+
+  const auto kTree = Tree::Build(values.begin(), values.end());
+  for (int i = 0; i < 500; ++i)
+  {
+    // Update a random element then check random ranges and the whole sequence
+    const std::size_t kIndex = generator() % values.size();
+    values[kIndex] = static_cast<int>(generator() % 21) - 10;
+    EXPECT_TRUE(kTree->Update(kIndex, values[kIndex]));
+    EXPECT_EQ(values[kIndex], kTree->Get(kIndex));
+
+    const std::size_t kFirst = generator() % (values.size() - 1);
+    const std::size_t kLast = kFirst + 1 + generator() % (values.size() - kFirst - 1);
+    EXPECT_EQ(MaxSubSequenceRange(values, kFirst, kLast), kTree->Query(kFirst, kLast));
+    EXPECT_EQ(MaxSubSequence<IT>(values.begin(), values.end()), kTree->Query(0, values.size() - 1));
+  }
+}
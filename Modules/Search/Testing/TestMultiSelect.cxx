@@ -0,0 +1,124 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <multi_select.hxx>
+
+// STD includes
+#include <functional>
+#include <random>
+
+using namespace huc::search;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  const int RandomArrayInt[] = {4, 3, 5, 2, -18, 3, 2, 3, 4, 5, -5}; // Simple random array of integers
+
+  typedef std::vector<int> Container;
+  typedef Container::iterator IT;
+  typedef std::greater_equal<Container::value_type> GR_Compare;
+
+  // Check each selected element and the partition of the sequence around it
+  void CheckSelection(const Container& sequence, const Container& sorted,
+                      const std::vector<unsigned int>& ks, const std::vector<IT>& kths)
+  {
+    ASSERT_EQ(ks.size(), kths.size());
+    for (std::size_t i = 0; i < ks.size(); ++i)
+    {
+      ASSERT_EQ(sequence.begin() + ks[i], kths[i]);
+      EXPECT_EQ(sorted[ks[i]], *kths[i]);
+      EXPECT_TRUE(std::all_of(sequence.begin(), sequence.begin() + ks[i],
+                              [&](int val) { return val <= *kths[i]; }));
+      EXPECT_TRUE(std::all_of(sequence.begin() + ks[i], sequence.end(),
+                              [&](int val) { return val >= *kths[i]; }));
+    }
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test multiple order statistics on small sequences
+TEST(TestSearch, MultiSelect)
+{
+  // Empty sequence - Should return end for each rank
+  {
+    Container emptyArray;
+    auto kths = MultiSelect<IT>(emptyArray.begin(), emptyArray.end(), std::vector<unsigned int>(2, 0));
+    ASSERT_EQ(2u, kths.size());
+    EXPECT_EQ(emptyArray.end(), kths[0]);
+    EXPECT_EQ(emptyArray.end(), kths[1]);
+  }
+
+  // Basic run on random array - ranks in any order, duplicated or out of the sequence
+  {
+    Container randomArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    const unsigned int kRanks[] = {7, 0, 100, 10, 7, 3};
+    const std::vector<unsigned int> kKs(kRanks, kRanks + sizeof(kRanks) / sizeof(unsigned int));
+    auto kths = MultiSelect<IT>(randomArray.begin(), randomArray.end(), kKs);
+    ASSERT_EQ(kKs.size(), kths.size());
+    EXPECT_EQ(4, *kths[0]);
+    EXPECT_EQ(-18, *kths[1]);
+    EXPECT_EQ(randomArray.end(), kths[2]);
+    EXPECT_EQ(5, *kths[3]);
+    EXPECT_EQ(4, *kths[4]);
+    EXPECT_EQ(2, *kths[5]);
+  }
+
+  // Biggest elements - Should return 5, 5, 4
+  {
+    Container randomArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    const unsigned int kRanks[] = {0, 1, 2};
+    auto kths = MultiSelect<IT, GR_Compare>(randomArray.begin(), randomArray.end(),
+                                            std::vector<unsigned int>(kRanks, kRanks + 3));
+    EXPECT_EQ(5, *kths[0]);
+    EXPECT_EQ(5, *kths[1]);
+    EXPECT_EQ(4, *kths[2]);
+  }
+}
+
+// Test percentiles on large sequences using both sequential and parallel versions
+TEST(TestSearch, MultiSelectPercentiles)
+{
+  const int kSize = 200003;
+  std::mt19937 generator(42);
+  Container random(kSize), fewUniques(kSize);
+  for (int i = 0; i < kSize; ++i)
+  {
+    random[i] = static_cast<int>(generator() % 1000000);
+    fewUniques[i] = static_cast<int>(generator() % 5);
+  }
+
+  const unsigned int kRanks[] = {kSize / 2, kSize * 9 / 10, kSize * 99 / 100, kSize * 999 / 1000, 0, kSize - 1};
+  const std::vector<unsigned int> kKs(kRanks, kRanks + sizeof(kRanks) / sizeof(unsigned int));
+  const Container* kSequences[] = {&random, &fewUniques};
+  for (auto seq = std::begin(kSequences); seq != std::end(kSequences); ++seq)
+  {
+    Container sorted = **seq;
+    std::sort(sorted.begin(), sorted.end());
+
+    Container sequence = **seq;
+    CheckSelection(sequence, sorted, kKs, MultiSelect<IT>(sequence.begin(), sequence.end(), kKs));
+
+    for (unsigned int threads = 1; threads <= 4; ++threads)
+    {
+      sequence = **seq;
+      CheckSelection(sequence, sorted, kKs,
+                     ParallelMultiSelect<IT>(sequence.begin(), sequence.end(), kKs, threads));
+    }
+  }
+}
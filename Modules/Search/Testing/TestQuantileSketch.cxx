@@ -0,0 +1,158 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <kth_order_statistic.hxx>
+#include <quantile_sketch.hxx>
+
+// STD includes
+#include <random>
+#include <thread>
+
+using namespace huc::search;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  const int RandomArrayInt[] = {4, 3, 5, 2, -18, 3, 2, 3, 4, 5, -5}; // Simple random array of integers
+
+  typedef std::vector<int> Container;
+  typedef Container::iterator IT;
+  typedef QuantileSketch<int> Sketch;
+
+  const double kQuantiles[] = {0., 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 1.};
+
+  // Maximal normalized rank error of the sketch quantiles given the exact KthOrderStatistic results
+  double MaxQuantileError(const Sketch& sketch, const Container& data)
+  {
+    Container sequence = data;
+    double maxError = 0;
+    for (auto q = std::begin(kQuantiles); q != std::end(kQuantiles); ++q)
+    {
+      const auto kRank = static_cast<unsigned int>(*q * (data.size() - 1));
+      const auto kExact = *KthOrderStatistic<IT>(sequence.begin(), sequence.end(), kRank);
+      const auto kApprox = sketch.Quantile(*q);
+
+      // Distance between the requested rank and the ranks range covered by the approximated value
+      const auto kLowRank = std::count_if(data.begin(), data.end(), [&](int val) { return val < kApprox; });
+      const auto kHighRank = std::count_if(data.begin(), data.end(), [&](int val) { return val <= kApprox; });
+      const double kError = (kRank < kLowRank) ? kLowRank - kRank :
+                            (kRank >= kHighRank) ? kRank - kHighRank + 1 : 0;
+      maxError = std::max(maxError, kError / data.size());
+      if (kApprox == kExact)
+      {
+        EXPECT_EQ(0., kError);
+      }
+    }
+    return maxError;
+  }
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test sketch on small streams: exact as long as nothing is compacted
+TEST(TestSearch, QuantileSketchSmall)
+{
+  // Empty sketch
+  {
+    Sketch sketch;
+    EXPECT_EQ(0u, sketch.Count());
+    EXPECT_EQ(0u, sketch.Rank(10));
+    EXPECT_EQ(0, sketch.Quantile(0.5));
+  }
+
+  // Random array - exact quantiles and ranks
+  {
+    const Container kRandomArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    Sketch sketch;
+    sketch.Insert(kRandomArray.begin(), kRandomArray.end());
+    EXPECT_EQ(kRandomArray.size(), sketch.Count());
+    EXPECT_EQ(-18, sketch.Quantile(0.));
+    EXPECT_EQ(3, sketch.Quantile(0.5));
+    EXPECT_EQ(5, sketch.Quantile(1.));
+    EXPECT_EQ(0u, sketch.Rank(-18));
+    EXPECT_EQ(4u, sketch.Rank(3));
+    EXPECT_EQ(11u, sketch.Rank(6));
+  }
+}
+
+// Test sketch accuracy and memory against exact KthOrderStatistic on large streams
+TEST(TestSearch, QuantileSketchAccuracy)
+{
+  const int kSize = 200000;
+  std::mt19937 generator(42);
+  Container random(kSize), sorted(kSize), duplicates(kSize);
+  for (int i = 0; i < kSize; ++i)
+  {
+    random[i] = static_cast<int>(generator() % 1000000);
+    sorted[i] = i;
+    duplicates[i] = static_cast<int>(generator() % 1000);
+  }
+
+  const Container* kStreams[] = {&random, &sorted, &duplicates};
+  for (auto stream = std::begin(kStreams); stream != std::end(kStreams); ++stream)
+  {
+    // Element by element
+    Sketch sketch(200);
+    for (auto it = (*stream)->begin(); it != (*stream)->end(); ++it)
+      sketch.Insert(*it);
+    EXPECT_EQ(static_cast<std::size_t>(kSize), sketch.Count());
+    EXPECT_GT(4u * 200 + 64, sketch.GetRetainedCount());
+    EXPECT_GT(0.02, MaxQuantileError(sketch, **stream));
+
+    // Batches - higher accuracy
+    Sketch accurateSketch(1000);
+    for (auto it = (*stream)->begin(); it != (*stream)->end(); it += 1000)
+      accurateSketch.Insert(it, it + 1000);
+    EXPECT_EQ(static_cast<std::size_t>(kSize), accurateSketch.Count());
+    EXPECT_GT(0.005, MaxQuantileError(accurateSketch, **stream));
+
+    // Rank of the median
+    const auto kMedianRank = accurateSketch.Rank(accurateSketch.Quantile(0.5));
+    EXPECT_GT(0.01 * kSize, std::abs(static_cast<double>(kMedianRank) - kSize / 2));
+  }
+}
+
+// Test sketches built by several threads then merged
+TEST(TestSearch, QuantileSketchMerge)
+{
+  const int kSize = 400000;
+  const unsigned int kThreads = 4;
+  std::mt19937 generator(7);
+  Container data(kSize);
+  for (auto it = data.begin(); it != data.end(); ++it)
+    *it = static_cast<int>(generator() % 100000);
+
+  std::vector<Sketch> sketches;
+  for (unsigned int t = 0; t < kThreads; ++t)
+    sketches.push_back(Sketch(200, t));
+
+  std::vector<std::thread> workers;
+  for (unsigned int t = 0; t < kThreads; ++t)
+    workers.push_back(std::thread([&, t]()
+    { sketches[t].Insert(data.begin() + t * kSize / kThreads, data.begin() + (t + 1) * kSize / kThreads); }));
+  for (auto it = workers.begin(); it != workers.end(); ++it)
+    it->join();
+
+  Sketch merged(200);
+  for (auto it = sketches.begin(); it != sketches.end(); ++it)
+    merged.Merge(*it);
+
+  EXPECT_EQ(static_cast<std::size_t>(kSize), merged.Count());
+  EXPECT_GT(4u * 200 + 64, merged.GetRetainedCount());
+  EXPECT_GT(0.02, MaxQuantileError(merged, data));
+}
@@ -0,0 +1,120 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#include <gtest/gtest.h>
+#include <window_order_statistic.hxx>
+
+// STD includes
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Testing namespace
+using namespace huc::search;
+
+#ifndef DOXYGEN_SKIP
+namespace {
+  typedef std::vector<int> Container;
+}
+#endif /* DOXYGEN_SKIP */
+
+// Test WindowOrderStatistic on empty and small windows
+TEST(TestSearch, WindowOrderStatistic)
+{
+  // Should return default values on empty window or out of range ranks
+  {
+    WindowOrderStatistic<int> window(3);
+    EXPECT_EQ(0u, window.Size());
+    EXPECT_EQ(0, window.Select(0));
+    EXPECT_EQ(0, window.Quantile(.5));
+    EXPECT_EQ(0u, window.Rank(10));
+    window.Push(4);
+    EXPECT_EQ(0, window.Select(1));
+  }
+
+  // Should keep the last three elements only
+  {
+    WindowOrderStatistic<int> window(3);
+    const int kValues[] = {4, 3, 5, 2, -18, 3};
+    for (auto it = std::begin(kValues); it != std::end(kValues); ++it)
+      window.Push(*it);
+
+    EXPECT_EQ(3u, window.Size());
+    EXPECT_EQ(6u, window.Count());
+    EXPECT_EQ(-18, window.Select(0));
+    EXPECT_EQ(2, window.Select(1));
+    EXPECT_EQ(3, window.Select(2));
+    EXPECT_EQ(2, window.Quantile(.5));
+    EXPECT_EQ(3, window.Quantile(1.));
+    EXPECT_EQ(2u, window.Rank(3));
+  }
+
+  // Unitary window
+  {
+    WindowOrderStatistic<int> window(1);
+    for (int i = 0; i < 10; ++i)
+    {
+      window.Push(10 - i);
+      EXPECT_EQ(10 - i, window.Select(0));
+    }
+  }
+}
+
+// Test WindowOrderStatistic against the sorted window content
+TEST(TestSearch, WindowOrderStatisticRandom)
+{
+  std::mt19937 generator(42);
+  const std::size_t kWindows[] = {2, 7, 100, 1000};
+  for (auto kWindow = std::begin(kWindows); kWindow != std::end(kWindows); ++kWindow)
+  {
+    // Values with many duplicates, then increasing values
+    Container values(5000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+      values[i] = (i < 3000) ? static_cast<int>(generator() % 50) : static_cast<int>(i);
+
+    WindowOrderStatistic<int> window(*kWindow);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      window.Push(values[i]);
+
+      const auto kFirst = values.begin() + (i + 1 - std::min(i + 1, *kWindow));
+      Container sorted(kFirst, values.begin() + i + 1);
+      std::sort(sorted.begin(), sorted.end());
+      ASSERT_EQ(sorted.size(), window.Size());
+
+      const std::size_t kRank = generator() % sorted.size();
+      EXPECT_EQ(sorted[kRank], window.Select(kRank));
+      EXPECT_EQ(sorted[(sorted.size() - 1) / 2], window.Quantile(.5));
+      EXPECT_EQ(sorted[static_cast<std::size_t>(.95 * (sorted.size() - 1))], window.Quantile(.95));
+
+      const int kValue = static_cast<int>(generator() % 60);
+      const auto kLower = std::lower_bound(sorted.begin(), sorted.end(), kValue);
+      EXPECT_EQ(static_cast<std::size_t>(std::distance(sorted.begin(), kLower)), window.Rank(kValue));
+    }
+  }
+
+  // Decreasing order statistics using std::greater
+  {
+    WindowOrderStatistic<int, std::greater<int>> window(5);
+    for (int i = 0; i < 20; ++i)
+      window.Push(i);
+    EXPECT_EQ(19, window.Select(0));
+    EXPECT_EQ(15, window.Select(4));
+  }
+}
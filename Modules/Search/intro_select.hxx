@@ -0,0 +1,188 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_SEARCH_INTRO_SELECT_HXX
+#define MODULE_SEARCH_INTRO_SELECT_HXX
+
+#include <Sort/partition.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+
+namespace huc
+{
+  namespace search
+  {
+    template <typename IT, typename Compare = std::less_equal<typename std::iterator_traits<IT>::value_type>>
+    IT IntroSelect(const IT& begin, const IT& end, unsigned int k);
+
+    /// Median Of Medians - Find a pivot guaranteed to be greater/smaller than 30% of the elements.
+    ///
+    /// @remark the medians of each group of 5 elements are moved to the beginning of the sequence,
+    /// their median is then selected in place using IntroSelect.
+    ///
+    /// @warning this method changes the elements order between your iterators.
+    ///
+    /// @tparam IT Random-access iterator type.
+    /// @tparam Compare functor type (std::less_equal for smaller elements first,
+    /// std::greater_equal for bigger elements first).
+    ///
+    /// @param begin,end - ITs to the initial and final positions of
+    /// the sequence. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    ///
+    /// @complexity O(n).
+    ///
+    /// @return the IT on the median of medians, the end IT on empty sequence.
+    template <typename IT, typename Compare = std::less_equal<typename std::iterator_traits<IT>::value_type>>
+    IT MedianOfMedians(const IT& begin, const IT& end)
+    {
+      const auto kSize = std::distance(begin, end);
+      if (kSize < 1)
+        return end;
+
+      // Sort each group of 5 elements and move its median at the beginning of the sequence
+      auto mediansEnd = begin;
+      for (auto groupIt = begin; groupIt < end; groupIt += std::min<decltype(kSize)>(5, end - groupIt))
+      {
+        const auto groupEnd = groupIt + std::min<decltype(kSize)>(5, end - groupIt);
+        for (auto it = groupIt + 1; it < groupEnd; ++it)
+          for (auto subIt = it; subIt > groupIt && !Compare()(*(subIt - 1), *subIt); --subIt)
+            std::swap(*(subIt - 1), *subIt);
+
+        std::swap(*(mediansEnd++), *(groupIt + std::distance(groupIt, groupEnd) / 2));
+      }
+
+      // Select the median of the medians
+      const auto kMediansCount = static_cast<unsigned int>(std::distance(begin, mediansEnd));
+      return IntroSelect<IT, Compare>(begin, mediansEnd, kMediansCount / 2);
+    }
+
+    /// Intro Select - Find the kth smallest/biggest element contained within [begin, end[.
+    ///
+    /// @details Iterative selection with a linear worst case:
+    /// - Pivots are chosen by Floyd-Rivest sampling on large sequences: the kth element of a small sample
+    ///   taken around k is selected first, reducing the sequence to a few elements around k in one pass.
+    /// - Sequences are split using a three-way partition, so that duplicates are never processed twice.
+    /// - As soon as two consecutive partitions fail to discard a quarter of the sequence, the next pivot
+    ///   is the median of medians which guarantees O(n) whatever the input.
+    ///
+    /// @warning this method is not stable (does not keep order with element of the same value).
+    /// @warning this method changes the elements order between your iterators: as for std::nth_element,
+    /// elements before the kth one are smaller/bigger (or equal) and elements after are bigger/smaller.
+    ///
+    /// @tparam IT Random-access iterator type.
+    /// @tparam Compare functor type (std::less_equal to find kth smallest element,
+    /// std::greater_equal to find the kth biggest one).
+    ///
+    /// @param begin,end - ITs to the initial and final positions of
+    /// the sequence. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param k the zero-based kth element - 0 for the biggest/smallest.
+    ///
+    /// @complexity O(n).
+    ///
+    /// @return the kth smallest IT element of the array, the end IT in case of failure.
+    template <typename IT, typename Compare>
+    IT IntroSelect(const IT& begin, const IT& end, unsigned int k)
+    {
+      typedef typename std::iterator_traits<IT>::difference_type Distance;
+      const int kSmallSize = 16;    // Sequences sorted by insertion
+      const int kSampleSize = 600;  // Sequences selected using Floyd-Rivest sampling
+
+      // Sequence does not contain enough elements: Could not find the k'th one.
+      const auto kSize = std::distance(begin, end);
+      if (kSize < 1 || k >= static_cast<unsigned int>(kSize))
+        return end;
+
+      const auto kth = begin + k;
+      auto lowIt = begin;
+      auto highIt = end;
+      int stalls = 0;
+      while (std::distance(lowIt, highIt) > kSmallSize)
+      {
+        const auto size = std::distance(lowIt, highIt);
+
+        // Pick pivot
+        auto pivot = lowIt;
+        if (stalls >= 2)
+        {
+          pivot = MedianOfMedians<IT, Compare>(lowIt, highIt);
+          stalls = 0;
+        }
+        else if (size > kSampleSize)
+        {
+          // Floyd-Rivest - Select the kth element of a sample to get a pivot close to it
+          const double n = static_cast<double>(size);
+          const double i = static_cast<double>(std::distance(lowIt, kth));
+          const double z = std::log(n);
+          const double s = 0.5 * std::exp(2 * z / 3);
+          const double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * ((i < n / 2) ? -1 : 1);
+          const double kSampleLow = std::max(0., i - i * s / n + sd);
+          const double kSampleHigh = std::min(n, i + (n - i) * s / n + sd);
+          const auto sampleBegin = lowIt + static_cast<Distance>(std::min(i, kSampleLow));
+          const auto sampleEnd = lowIt + static_cast<Distance>(std::max(i + 1, kSampleHigh));
+
+          // Gather elements spread over the sequence: the sequence may be partially ordered
+          const auto kStride = size / std::distance(sampleBegin, sampleEnd);
+          auto sampledIt = lowIt;
+          for (auto it = sampleBegin; it != sampleEnd; ++it, sampledIt += kStride)
+            std::swap(*it, *sampledIt);
+
+          IntroSelect<IT, Compare>(sampleBegin, sampleEnd, static_cast<unsigned int>(kth - sampleBegin));
+          pivot = kth;
+        }
+        else
+        {
+          // Median of three
+          auto midIt = lowIt + size / 2;
+          auto lastIt = highIt - 1;
+          if (!Compare()(*lowIt, *midIt)) std::swap(*lowIt, *midIt);
+          if (!Compare()(*midIt, *lastIt)) std::swap(*midIt, *lastIt);
+          if (!Compare()(*lowIt, *midIt)) std::swap(*lowIt, *midIt);
+          pivot = midIt;
+        }
+
+        // Partition and keep searching within the sequence containing k
+        const auto bounds = sort::ThreeWayPartition<IT, Compare>(lowIt, pivot, highIt);
+        if (kth < bounds.first)
+          highIt = bounds.first;
+        else if (kth >= bounds.second)
+          lowIt = bounds.second;
+        else
+          return kth;
+
+        // Keep track of the partitions that do not reduce enough the search space
+        stalls = (std::distance(lowIt, highIt) * 4 > size * 3) ? stalls + 1 : 0;
+      }
+
+      // Insertion sort of the remaining elements
+      for (auto it = lowIt + 1; it < highIt; ++it)
+        for (auto subIt = it; subIt > lowIt && !Compare()(*(subIt - 1), *subIt); --subIt)
+          std::swap(*(subIt - 1), *subIt);
+
+      return kth;
+    }
+  }
+}
+
+#endif // MODULE_SEARCH_INTRO_SELECT_HXX
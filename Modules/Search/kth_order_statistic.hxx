@@ -34,6 +34,8 @@ namespace huc
     /// @warning this method is not stable (does not keep order with element of the same value).
     /// @warning this method changes the elements order between your iterators.
     ///
+    /// @remark the random pivot gives no worst case guarantee: use IntroSelect for a linear worst case.
+    ///
     /// @tparam IT Random-access iterator type.
     /// @tparam Compare functor type (std::less_equal to find kth smallest element,
     /// std::greater_equal to find the kth biggest one).
@@ -0,0 +1,266 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_SEARCH_LEARNED_INDEX_HXX
+#define MODULE_SEARCH_LEARNED_INDEX_HXX
+
+#include <Search/binary.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace huc
+{
+  namespace search
+  {
+    /// @class LearnedIndex
+    ///
+    /// A Learned Index replaces the comparisons of a binary search by a model predicting the position of
+    /// a key within a sorted sequence. The model is a piecewise-linear approximation of the keys
+    /// cumulative distribution, built so that each prediction is at most epsilon positions away from the
+    /// real one: a lookup is then a prediction followed by a BinarySearch bounded to [pos-ε, pos+ε].
+    ///
+    /// Segments are computed in one streaming pass using a shrinking cone: the cone of valid slopes
+    /// starting at the first key of a segment is narrowed by each new key, and a new segment starts as
+    /// soon as the cone becomes empty. As in a PGM index, the segments first keys are themselves indexed
+    /// recursively by the same model until a unique root segment remains.
+    ///
+    /// @advantages
+    /// - Model size depends on the keys distribution regularity, not on the number of keys.
+    /// - Lookups touch a handful of cache lines (one per level and the final bounded search window).
+    /// - Construction is linear and does not copy the keys.
+    ///
+    /// @drawbacks
+    /// - The keys are not owned: the sequence must outlive the index and must not be modified.
+    /// - Performs poorly (many segments) on erratic keys distribution.
+    ///
+    /// @tparam IT Random-access iterator type on sorted arithmetic values.
+    /// @tparam IsEqual functor type used to identify the key once the search window is reached.
+    template <typename IT,
+              typename IsEqual = std::equal_to<typename std::iterator_traits<IT>::value_type>>
+    class LearnedIndex
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+
+      /// Segment - Linear model predicting positions for keys within [key, next segment key[.
+      struct Segment
+      {
+        Segment(const Value& key, std::size_t position, double slope) :
+          key(key), position(position), slope(slope) {}
+
+        Value key;
+        std::size_t position;
+        double slope;
+      };
+
+      typedef std::vector<Segment> Level;
+
+    public:
+      /// Build - Construct the model on the sorted sequence in a single pass.
+      ///
+      /// @param begin,end - ITs to the initial and final positions of
+      /// the sorted sequence to be indexed. The range used is [first,last), which contains
+      /// all the elements between first and last, including the element pointed by first but
+      /// not the element pointed by last.
+      /// @param epsilon maximal error (in positions) between a prediction and the real position.
+      ///
+      /// @complexity O(n).
+      ///
+      /// @warning the algorithm does not check the validity on data order; using this algorithm with
+      /// unordored data will result in an index unable to find the keys.
+      ///
+      /// @return Learned Index pointer to be owned, nullptr if construction failed.
+      static std::unique_ptr<LearnedIndex> Build(const IT& begin, const IT& end, unsigned int epsilon = 64)
+      {
+        if (begin >= end || epsilon < 1)
+          return nullptr;
+
+        auto index = std::unique_ptr<LearnedIndex>(new LearnedIndex(begin, end, epsilon));
+
+        // Data level then recursive levels over the segments keys until a unique root remains
+        index->levels.push_back(BuildLevel(begin, end, epsilon));
+        while (index->levels.back().size() > 1)
+        {
+          const auto& lower = index->levels.back();
+          std::vector<Value> keys;
+          keys.reserve(lower.size());
+          for (auto it = lower.begin(); it != lower.end(); ++it)
+            keys.push_back(it->key);
+          index->levels.push_back(BuildLevel(keys.begin(), keys.end(), epsilon));
+        }
+
+        return index;
+      }
+
+      /// Find the position of a key within the indexed sequence.
+      ///
+      /// @param key the key value to be searched.
+      ///
+      /// @complexity O(L * log(ε)) where L is the number of levels of the model.
+      ///
+      /// @return The index of the first key occurence found, -1 if not found (cf. BinarySearch).
+      int Find(const Value& key) const
+      {
+        if (key < *this->begin)
+          return -1;
+
+        // Walk down the levels: each one predicts the segment to be used within the lower one
+        std::size_t segmentIdx = 0;
+        for (auto level = this->levels.size() - 1; level > 0; --level)
+        {
+          const auto& lower = this->levels[level - 1];
+          const auto window = this->Window(this->levels[level], segmentIdx, lower.size(), key);
+
+          // Last segment whose first key is lower or equal to the key
+          auto it = std::upper_bound(lower.begin() + window.first, lower.begin() + window.second, key,
+                                     [](const Value& val, const Segment& seg) { return val < seg.key; });
+          segmentIdx = static_cast<std::size_t>(std::distance(lower.begin(), it)) - 1;
+        }
+
+        // Bounded binary search on the data
+        const auto window = this->Window(this->levels.front(), segmentIdx, this->size, key);
+        const auto index =
+          BinarySearch<IT, IsEqual>(this->begin + window.first, this->begin + window.second, key);
+        return (index < 0) ? -1 : index + static_cast<int>(window.first);
+      }
+
+      /// @return the maximal prediction error (in positions) of the model.
+      unsigned int GetEpsilon() const { return this->epsilon; }
+
+      /// @return the number of levels composing the model (1 for a model made of a unique segment).
+      std::size_t GetHeight() const { return this->levels.size(); }
+
+      /// @return the number of segments composing the model (all levels included).
+      std::size_t GetSegmentCount() const
+      {
+        std::size_t count = 0;
+        for (auto it = this->levels.begin(); it != this->levels.end(); ++it)
+          count += it->size();
+        return count;
+      }
+
+      /// @return the memory used by the model in bytes (keys excluded as not owned).
+      std::size_t GetModelSize() const
+      { return sizeof(LearnedIndex) + this->GetSegmentCount() * sizeof(Segment); }
+
+    private:
+      LearnedIndex(const IT& begin, const IT& end, unsigned int epsilon) :
+        begin(begin), size(static_cast<std::size_t>(std::distance(begin, end))), epsilon(epsilon) {}
+      LearnedIndex(LearnedIndex&) {}           // Not Implemented
+      LearnedIndex operator=(LearnedIndex&) {} // Not Implemented
+
+      /// Exact positive distance between two ordered keys (no overflow on wide integral ranges).
+      template <typename T>
+      static double Delta(const T& low, const T& high, std::true_type /*isIntegral*/)
+      {
+        typedef typename std::make_unsigned<T>::type Unsigned;
+        return static_cast<double>(static_cast<Unsigned>(high) - static_cast<Unsigned>(low));
+      }
+      template <typename T>
+      static double Delta(const T& low, const T& high, std::false_type /*isIntegral*/)
+      { return static_cast<double>(high - low); }
+      static double Delta(const Value& low, const Value& high)
+      { return Delta(low, high, typename std::is_integral<Value>::type()); }
+
+      /// BuildLevel - Shrinking cone segmentation of a sorted sequence.
+      /// Only the first occurence of each key is used as training point.
+      template <typename KeyIT>
+      static Level BuildLevel(const KeyIT& begin, const KeyIT& end, unsigned int epsilon)
+      {
+        Level level;
+        const double kEps = static_cast<double>(epsilon);
+        double lowSlope = 0;
+        double highSlope = std::numeric_limits<double>::infinity();
+        auto lCloseSegment = [&]()
+        {
+          level.back().slope = (highSlope == std::numeric_limits<double>::infinity()) ?
+                               lowSlope : (lowSlope + highSlope) / 2;
+        };
+
+        level.push_back(Segment(*begin, 0, 0));
+        std::size_t position = 1;
+        for (auto it = begin + 1; it != end; ++it, ++position)
+        {
+          // Duplicates share the position of their first occurence
+          if (!(*(it - 1) < *it))
+            continue;
+
+          // Slopes range satisfying the error bound for this point
+          const auto dx = Delta(level.back().key, *it);
+          const auto dy = static_cast<double>(position - level.back().position);
+          const auto low = (dy - kEps) / dx;
+          const auto high = (dy + kEps) / dx;
+
+          // Cone still open: shrink it
+          if (low <= highSlope && high >= lowSlope)
+          {
+            lowSlope = std::max(lowSlope, low);
+            highSlope = std::min(highSlope, high);
+            continue;
+          }
+
+          // Cone is empty: close current segment and start a new one from this point
+          lCloseSegment();
+          level.push_back(Segment(*it, position, 0));
+          lowSlope = 0;
+          highSlope = std::numeric_limits<double>::infinity();
+        }
+        lCloseSegment();
+
+        return level;
+      }
+
+      /// Window - Compute the search window [first, second[ within the lower level for the key.
+      ///
+      /// @remark the prediction is clamped on the positions covered by the segment and the window is
+      /// enlarged by one position on each side to absorb the rounding of the predictions.
+      std::pair<std::size_t, std::size_t>
+      Window(const Level& level, std::size_t segmentIdx, std::size_t lowerSize, const Value& key) const
+      {
+        const auto& segment = level[segmentIdx];
+        const auto limit = (segmentIdx + 1 < level.size()) ? level[segmentIdx + 1].position : lowerSize;
+
+        const double kPrediction = static_cast<double>(segment.position) +
+                                   segment.slope * Delta(segment.key, key);
+        const auto kMaxPosition = static_cast<double>(limit - 1);
+        const auto position = static_cast<std::size_t>(
+          std::min(kMaxPosition, std::max(static_cast<double>(segment.position), std::floor(kPrediction))));
+
+        const std::size_t kMargin = this->epsilon + 1;
+        const auto first = (position > segment.position + kMargin) ? position - kMargin : segment.position;
+        const auto second = std::min(limit, position + kMargin + 1);
+        return std::make_pair(first, second);
+      }
+
+      IT begin;                   // First key of the indexed sequence
+      std::size_t size;           // Number of keys indexed
+      unsigned int epsilon;       // Maximal prediction error
+      std::vector<Level> levels;  // Model levels, from the data one [0] to the root one [back]
+    };
+  }
+}
+
+#endif // MODULE_SEARCH_LEARNED_INDEX_HXX
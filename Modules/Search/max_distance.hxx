@@ -21,8 +21,17 @@
 #define MODULE_SEARCH_MAX_DISTANCE_HXX
 
 // STD includes
+#include <algorithm>
+#include <functional>
 #include <iterator>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace huc
 {
@@ -73,6 +82,526 @@ namespace huc
 
       return indexes;
     }
+
+    /// @class MaxDistanceStream
+    ///
+    /// Streaming version of MaxDistance: values are pushed one by one (or by batches) and the indexes of
+    /// the maximal distance found so far are available at any time in O(1).
+    ///
+    /// @advantages
+    /// - O(1) per value and O(1) memory, the values are not stored.
+    /// - Same indexes as MaxDistance on the sequence of the values pushed.
+    ///
+    /// @tparam T type of the values.
+    /// @tparam Distance functor type computing the distance between two elements.
+    template <typename T, typename Distance = std::minus<T>>
+    class MaxDistanceStream
+    {
+    public:
+      MaxDistanceStream() : count(0), minValue(), minIdx(0), maxDist(), indexes(-1, -1) {}
+
+      /// Push a new value at the end of the sequence.
+      ///
+      /// @param value the value to be pushed.
+      ///
+      /// @complexity O(1).
+      void Push(const T& value)
+      {
+        if (this->count < 2)
+        {
+          if (this->count++ == 0)
+          {
+            this->minValue = value;
+            return;
+          }
+
+          this->maxDist = Distance()(this->minValue, value);
+          this->indexes = std::pair<long long, long long>(0, 1);
+          this->Process(value, 1);
+          return;
+        }
+
+        this->Process(value, this->count++);
+      }
+
+      /// Push a batch of values at the end of the sequence.
+      ///
+      /// @param begin,end iterators to the initial and final positions of
+      /// the values to be pushed. The range used is [first,last), which contains all the elements between
+      /// first and last, including the element pointed by first but not the element pointed by last.
+      ///
+      /// @complexity O(n).
+      template <typename IT>
+      void Push(const IT& begin, const IT& end)
+      {
+        auto it = begin;
+        for (; it != end && this->count < 2; ++it)
+          this->Push(*it);
+
+        // Scan using local copies of the state
+        auto kMinValue = this->minValue;
+        auto kMinIdx = this->minIdx;
+        auto kMaxDist = this->maxDist;
+        auto kIndexes = this->indexes;
+        auto currentIdx = this->count;
+        for (; it != end; ++it, ++currentIdx)
+        {
+          if (*it < kMinValue)
+          {
+            kMinValue = *it;
+            kMinIdx = currentIdx;
+          }
+
+          const auto distance = Distance()(*it, kMinValue);
+          if (distance > kMaxDist)
+          {
+            kMaxDist = distance;
+            kIndexes.first = kMinIdx;
+            kIndexes.second = currentIdx;
+          }
+        }
+
+        this->minValue = kMinValue;
+        this->minIdx = kMinIdx;
+        this->maxDist = kMaxDist;
+        this->indexes = kIndexes;
+        this->count = currentIdx;
+      }
+
+      /// @return indexes of the maximal distance found so far, <-1,-1> if less than two values were pushed.
+      const std::pair<long long, long long>& Best() const { return this->indexes; }
+
+      /// @return the maximal distance found so far (undefined if less than two values were pushed).
+      const T& BestDistance() const { return this->maxDist; }
+
+      /// @return the number of values pushed.
+      long long Count() const { return this->count; }
+
+    private:
+      void Process(const T& value, long long currentIdx)
+      {
+        // Keeps track of the minimum value index
+        if (value < this->minValue)
+        {
+          this->minValue = value;
+          this->minIdx = currentIdx;
+        }
+
+        // Keeps track of the largest distance and the indexes
+        const auto distance = Distance()(value, this->minValue);
+        if (distance > this->maxDist)
+        {
+          this->maxDist = distance;
+          this->indexes.first = this->minIdx;
+          this->indexes.second = currentIdx;
+        }
+      }
+
+      long long count;                          // Number of values pushed
+      T minValue;                               // Minimum value pushed (first occurence)
+      long long minIdx;                         // Index of the minimum value
+      T maxDist;                                // Maximal distance found
+      std::pair<long long, long long> indexes;  // Indexes of the maximal distance
+    };
+
+    /// Distance Summary - Reduction of a range of values for MaxDistance.
+    ///
+    /// @details Keeps the minimum and maximum values (first occurences) and the maximal distance of the
+    /// range where each value may also be sold at its own price. Summaries of two consecutive ranges are
+    /// combined using an associative operator (cf. CombineDistance).
+    ///
+    /// @tparam T type of the values.
+    template <typename T>
+    struct DistanceSummary
+    {
+      /// Leaf - Summary of the single value range.
+      template <typename Distance = std::minus<T>>
+      static DistanceSummary Leaf(const T& value, long long idx)
+      {
+        DistanceSummary leaf = { value, idx, value, idx, Distance()(value, value), idx, idx };
+        return leaf;
+      }
+
+      T min;            // Minimum value
+      long long minIdx;
+      T max;            // Maximum value
+      long long maxIdx;
+      T best;           // Maximal distance and its indexes
+      long long first;
+      long long second;
+    };
+
+    /// CombineDistance - Summary of the concatenation of two consecutive ranges.
+    ///
+    /// @details The maximal distance either lies within one of the ranges, or goes from the left minimum
+    /// to the right maximum. Ties are solved in favor of the first sell index then of the first buy one,
+    /// as does MaxDistance.
+    ///
+    /// @tparam T type of the values.
+    /// @tparam Distance functor type computing the distance between two elements; must be translation
+    /// invariant as std::minus is.
+    ///
+    /// @param left,right summaries of the left and right ranges.
+    ///
+    /// @complexity O(1).
+    ///
+    /// @return the summary of the concatenated ranges.
+    template <typename T, typename Distance = std::minus<T>>
+    DistanceSummary<T> CombineDistance(const DistanceSummary<T>& left, const DistanceSummary<T>& right)
+    {
+      DistanceSummary<T> summary = left;
+      if (right.min < left.min)
+      {
+        summary.min = right.min;
+        summary.minIdx = right.minIdx;
+      }
+      if (right.max > left.max)
+      {
+        summary.max = right.max;
+        summary.maxIdx = right.maxIdx;
+      }
+
+      const auto kCrossing = Distance()(right.max, left.min);
+      const bool kUseRight = right.best > kCrossing ||
+                             (!(kCrossing > right.best) && right.second < right.maxIdx);
+      const auto kRightBest = kUseRight ? right.best : kCrossing;
+      if (kRightBest > left.best)
+      {
+        summary.best = kRightBest;
+        summary.first = kUseRight ? right.first : left.minIdx;
+        summary.second = kUseRight ? right.second : right.maxIdx;
+      }
+
+      return summary;
+    }
+
+    /// Distance Indexes - MaxDistance indexes of a range of at least two values from its summary.
+    ///
+    /// @param summary the summary of the range.
+    /// @param firstIdx index of the first value of the range.
+    /// @param first,second the two first values of the range.
+    ///
+    /// @return indexes of the range with the maximal distance (cf. MaxDistance).
+    template <typename T, typename Distance = std::minus<T>>
+    std::pair<long long, long long>
+    DistanceIndexes(const DistanceSummary<T>& summary, long long firstIdx, const T& first, const T& second)
+    {
+      // MaxDistance starts with the distance between the two first values, which must be beaten
+      if (!(summary.best > Distance()(first, second)))
+        return std::pair<long long, long long>(firstIdx, firstIdx + 1);
+
+      // The first value cannot be a sell one: the next one has the same null distance
+      if (summary.second == firstIdx)
+        return std::pair<long long, long long>((second < first) ? firstIdx + 1 : firstIdx, firstIdx + 1);
+
+      return std::pair<long long, long long>(summary.first, summary.second);
+    }
+
+    /// Distance Filter - Check whether the values of a block can update the summary of a scan: a value
+    /// lower than the minimum, greater than the maximum or whose distance to the minimum beats the best.
+    ///
+    /// @remark the SSE2 versions are used on contiguous int, float and double sequences with std::minus:
+    /// distances are computed the same way as the scalar ones, so that the results are identical.
+    ///
+    /// @tparam T type of the values.
+    /// @tparam Distance functor type computing the distance between two elements.
+    template <typename T, typename Distance>
+    struct DistanceFilter
+    {
+      static const bool kEnabled = false;
+      static const int kBlockSize = 8;
+
+      template <typename IT>
+      static bool Any(const IT&, const DistanceSummary<T>&) { return true; }
+    };
+
+#if defined(__SSE2__)
+    template <typename T> struct SimdDistance {};
+    template <> struct SimdDistance<int>
+    {
+      typedef __m128i Vector;
+      static const int kSize = 4;
+      static Vector Set(int val) { return _mm_set1_epi32(val); }
+      static Vector Load(const int* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+      static Vector Sub(Vector a, Vector b) { return _mm_sub_epi32(a, b); }
+      static Vector Greater(Vector a, Vector b) { return _mm_cmpgt_epi32(a, b); }
+      static Vector Or(Vector a, Vector b) { return _mm_or_si128(a, b); }
+      static int Mask(Vector a) { return _mm_movemask_epi8(a); }
+    };
+    template <> struct SimdDistance<float>
+    {
+      typedef __m128 Vector;
+      static const int kSize = 4;
+      static Vector Set(float val) { return _mm_set1_ps(val); }
+      static Vector Load(const float* data) { return _mm_loadu_ps(data); }
+      static Vector Sub(Vector a, Vector b) { return _mm_sub_ps(a, b); }
+      static Vector Greater(Vector a, Vector b) { return _mm_cmpgt_ps(a, b); }
+      static Vector Or(Vector a, Vector b) { return _mm_or_ps(a, b); }
+      static int Mask(Vector a) { return _mm_movemask_ps(a); }
+    };
+    template <> struct SimdDistance<double>
+    {
+      typedef __m128d Vector;
+      static const int kSize = 2;
+      static Vector Set(double val) { return _mm_set1_pd(val); }
+      static Vector Load(const double* data) { return _mm_loadu_pd(data); }
+      static Vector Sub(Vector a, Vector b) { return _mm_sub_pd(a, b); }
+      static Vector Greater(Vector a, Vector b) { return _mm_cmpgt_pd(a, b); }
+      static Vector Or(Vector a, Vector b) { return _mm_or_pd(a, b); }
+      static int Mask(Vector a) { return _mm_movemask_pd(a); }
+    };
+
+    /// SIMD Distance Filter
+    template <typename T>
+    struct SimdDistanceFilter
+    {
+      typedef SimdDistance<T> Simd;
+      static const bool kEnabled = true;
+      static const int kBlockSize = 8;
+
+      template <typename IT>
+      static bool Any(const IT& it, const DistanceSummary<T>& summary)
+      {
+        const T* data = &*it;
+        const auto kMin = Simd::Set(summary.min);
+        const auto kMax = Simd::Set(summary.max);
+        const auto kBest = Simd::Set(summary.best);
+        auto mask = Simd::Set(0);
+        for (int i = 0; i < kBlockSize; i += Simd::kSize)
+        {
+          const auto kValues = Simd::Load(data + i);
+          mask = Simd::Or(mask, Simd::Or(Simd::Greater(kMin, kValues), Simd::Greater(kValues, kMax)));
+          mask = Simd::Or(mask, Simd::Greater(Simd::Sub(kValues, kMin), kBest));
+        }
+        return Simd::Mask(mask) != 0;
+      }
+    };
+
+    template <> struct DistanceFilter<int, std::minus<int>> : SimdDistanceFilter<int> {};
+    template <> struct DistanceFilter<float, std::minus<float>> : SimdDistanceFilter<float> {};
+    template <> struct DistanceFilter<double, std::minus<double>> : SimdDistanceFilter<double> {};
+#endif
+
+    /// Distance Scan - Summary of the range [first, last) of the sequence.
+    ///
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Distance functor type computing the distance between two elements.
+    ///
+    /// @param begin iterator to the initial position of the whole sequence (used for indexes).
+    /// @param first,last iterators to the initial and final positions of the non-empty range.
+    ///
+    /// @complexity O(n), blocks of values are skipped using DistanceFilter on contiguous sequences.
+    ///
+    /// @return the summary of the range.
+    template <typename IT, typename Distance = std::minus<typename std::iterator_traits<IT>::value_type>>
+    DistanceSummary<typename std::iterator_traits<IT>::value_type>
+    DistanceScan(const IT& begin, const IT& first, const IT& last)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef DistanceFilter<Value, Distance> Filter;
+      const bool kIsContiguous = std::is_pointer<IT>::value ||
+                                 std::is_same<IT, typename std::vector<Value>::iterator>::value ||
+                                 std::is_same<IT, typename std::vector<Value>::const_iterator>::value;
+
+      long long currentIdx = static_cast<long long>(std::distance(begin, first));
+      auto summary = DistanceSummary<Value>::template Leaf<Distance>(*first, currentIdx);
+      auto lUpdate = [&](const IT& it)
+      {
+        if (*it < summary.min)
+        {
+          summary.min = *it;
+          summary.minIdx = currentIdx;
+        }
+        if (*it > summary.max)
+        {
+          summary.max = *it;
+          summary.maxIdx = currentIdx;
+        }
+
+        const auto distance = Distance()(*it, summary.min);
+        if (distance > summary.best)
+        {
+          summary.best = distance;
+          summary.first = summary.minIdx;
+          summary.second = currentIdx;
+        }
+      };
+
+      auto it = first + 1;
+      ++currentIdx;
+      if (Filter::kEnabled && kIsContiguous)
+        for (; std::distance(it, last) >= Filter::kBlockSize; )
+        {
+          if (!Filter::Any(it, summary))
+          {
+            it += Filter::kBlockSize;
+            currentIdx += Filter::kBlockSize;
+            continue;
+          }
+          for (const auto blockEnd = it + Filter::kBlockSize; it != blockEnd; ++it, ++currentIdx)
+            lUpdate(it);
+        }
+      for (; it != last; ++it, ++currentIdx)
+        lUpdate(it);
+
+      return summary;
+    }
+
+    /// Parallel Max Distance - Multi-threaded version of MaxDistance.
+    ///
+    /// @details Each thread computes the summary of its chunk (cf. DistanceScan), summaries are then
+    /// combined in order (cf. CombineDistance) to get the maximal distance of the whole sequence.
+    ///
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Distance functor type computing the distance between two elements; must be translation
+    /// invariant as std::minus is.
+    ///
+    /// @param begin,end iterators to the initial and final positions of
+    /// the sequence to be sorted. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param threads number of threads to be used (hardware concurrency by default).
+    ///
+    /// @return indexes of the array with the maximal distance (same as MaxDistance), <-1,-1> in case of
+    /// error.
+    template <typename IT, typename Distance = std::minus<typename std::iterator_traits<IT>::value_type>>
+    std::pair<int, int> ParallelMaxDistance(const IT& begin, const IT& end,
+                                            unsigned int threads = std::thread::hardware_concurrency())
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef typename std::iterator_traits<IT>::difference_type Difference;
+      const Difference kMinChunkSize = 4096;
+
+      const auto kSize = std::distance(begin, end);
+      threads = static_cast<unsigned int>(std::min<Difference>(std::max(1u, threads), kSize / kMinChunkSize));
+      if (threads < 2)
+        return MaxDistance<IT, Distance>(begin, end);
+
+      const Difference kChunkSize = (kSize + threads - 1) / threads;
+      std::vector<DistanceSummary<Value>> summaries(threads);
+      std::vector<std::thread> workers;
+      for (unsigned int t = 0; t < threads; ++t)
+      {
+        const auto chunkBegin = begin + std::min(kSize, t * kChunkSize);
+        const auto chunkEnd = begin + std::min(kSize, (t + 1) * kChunkSize);
+        if (chunkBegin == chunkEnd)
+          break;
+        workers.push_back(std::thread([&summaries, &begin, t, chunkBegin, chunkEnd]()
+        { summaries[t] = DistanceScan<IT, Distance>(begin, chunkBegin, chunkEnd); }));
+      }
+      for (auto it = workers.begin(); it != workers.end(); ++it)
+        it->join();
+
+      auto summary = summaries.front();
+      for (std::size_t t = 1; t < workers.size(); ++t)
+        summary = CombineDistance<Value, Distance>(summary, summaries[t]);
+
+      const auto kIndexes = DistanceIndexes<Value, Distance>(summary, 0, *begin, *(begin + 1));
+      return std::pair<int, int>(static_cast<int>(kIndexes.first), static_cast<int>(kIndexes.second));
+    }
+
+    /// @class MaxDistanceWindow
+    ///
+    /// Sliding window version of MaxDistance: values are pushed one by one and the indexes of the maximal
+    /// distance within the last W values are available at any time.
+    ///
+    /// @details The window is a queue made of two stacks (front and back) of summaries (cf.
+    /// DistanceSummary): the back stack is aggregated on each push, the front one stores the aggregates of
+    /// each of its suffixes: it is rebuilt from the back stack values once empty.
+    ///
+    /// @advantages
+    /// - Amortized O(1) per value, contiguous O(W) memory allocated once.
+    /// - Same indexes as MaxDistance on the last W values pushed.
+    ///
+    /// @drawbacks
+    /// - The front stack rebuild takes O(W) every W values.
+    ///
+    /// @tparam T type of the values.
+    /// @tparam Distance functor type computing the distance between two elements; must be translation
+    /// invariant as std::minus is.
+    template <typename T, typename Distance = std::minus<T>>
+    class MaxDistanceWindow
+    {
+      typedef DistanceSummary<T> Summary;
+
+    public:
+      /// @param window number of values W kept in the window (2 at least).
+      explicit MaxDistanceWindow(std::size_t window) :
+        window(std::max<std::size_t>(2, window)), count(0), size(0), frontSize(0),
+        values(this->window), front(this->window) {}
+
+      /// Push a new value, the oldest value is removed from the window if full.
+      ///
+      /// @param value the value to be pushed.
+      ///
+      /// @complexity Amortized O(1), O(W) on front stack rebuild.
+      void Push(const T& value)
+      {
+        if (this->size == this->window)
+          this->Pop();
+
+        const auto kLeaf = Summary::template Leaf<Distance>(value, this->count);
+        this->back = (this->size == this->frontSize) ? kLeaf :
+                     CombineDistance<T, Distance>(this->back, kLeaf);
+        this->values[static_cast<std::size_t>(this->count % static_cast<long long>(this->window))] = value;
+        ++this->count;
+        ++this->size;
+      }
+
+      /// @return indexes (since the first value pushed) of the maximal distance within the window,
+      /// <-1,-1> if it contains less than two values.
+      std::pair<long long, long long> Best() const
+      {
+        if (this->size < 2)
+          return std::pair<long long, long long>(-1, -1);
+
+        const auto& kSummary = (this->frontSize == 0) ? this->back :
+                               (this->frontSize == this->size) ? this->front[this->frontSize - 1] :
+                               CombineDistance<T, Distance>(this->front[this->frontSize - 1], this->back);
+
+        const auto kFirstIdx = this->count - static_cast<long long>(this->size);
+        return DistanceIndexes<T, Distance>(kSummary, kFirstIdx,
+                                            this->Value(kFirstIdx), this->Value(kFirstIdx + 1));
+      }
+
+      /// @return the number of values pushed.
+      long long Count() const { return this->count; }
+
+      /// @return the number of values within the window.
+      std::size_t Size() const { return this->size; }
+
+    private:
+      /// Pop - Remove the oldest value from the window.
+      void Pop()
+      {
+        // Rebuild the front stack using the values of the back one
+        if (this->frontSize == 0)
+        {
+          auto idx = this->count - 1;
+          this->front[0] = Summary::template Leaf<Distance>(this->Value(idx), idx);
+          for (std::size_t i = 1; i < this->size; ++i)
+          {
+            --idx;
+            const auto kLeaf = Summary::template Leaf<Distance>(this->Value(idx), idx);
+            this->front[i] = CombineDistance<T, Distance>(kLeaf, this->front[i - 1]);
+          }
+          this->frontSize = this->size;
+        }
+
+        --this->frontSize;
+        --this->size;
+      }
+
+      const T& Value(long long idx) const
+      { return this->values[static_cast<std::size_t>(idx % static_cast<long long>(this->window))]; }
+
+      std::size_t window;          // Maximal number of values W within the window
+      long long count;             // Number of values pushed
+      std::size_t size;            // Number of values within the window
+      std::size_t frontSize;       // Number of values within the front stack
+      std::vector<T> values;       // Window values, circular buffer
+      std::vector<Summary> front;  // Front stack, [i] summary of the i + 1 newest front values
+      Summary back;                // Summary of the back stack values
+    };
   }
 }
 
@@ -21,8 +21,17 @@
 #define MODULE_SEARCH_MAX_M_ELEMENTS_HXX
 
 // STD includes
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace huc
 {
@@ -74,6 +83,227 @@ namespace huc
 
       return maxMElements;
     }
+
+    /// Threshold Filter - Check whether any element of a block strictly beats a threshold.
+    ///
+    /// @remark allows to skip whole blocks of elements that cannot enter the current m elements: the
+    /// generic version is branchless and the SSE2 ones are used on contiguous int, float and double
+    /// sequences compared using the standard comparators.
+    ///
+    /// @tparam T type of the elements.
+    /// @tparam Compare functor type (cf. MaxMElements).
+    template <typename T, typename Compare>
+    struct ThresholdFilter
+    {
+      static const int kBlockSize = 16;
+
+      template <typename IT>
+      static bool Any(const IT& it, const T& threshold)
+      {
+        bool any = false;
+        for (int i = 0; i < kBlockSize; ++i)
+          any |= !Compare()(threshold, *(it + i));
+        return any;
+      }
+    };
+
+#if defined(__SSE2__)
+    template <typename T> struct SimdCompare {};
+    template <> struct SimdCompare<int>
+    {
+      typedef __m128i Vector;
+      static const int kSize = 4;
+      static Vector Set(int val) { return _mm_set1_epi32(val); }
+      static Vector Load(const int* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+      static int Greater(Vector a, Vector b) { return _mm_movemask_epi8(_mm_cmpgt_epi32(a, b)); }
+    };
+    template <> struct SimdCompare<float>
+    {
+      typedef __m128 Vector;
+      static const int kSize = 4;
+      static Vector Set(float val) { return _mm_set1_ps(val); }
+      static Vector Load(const float* data) { return _mm_loadu_ps(data); }
+      static int Greater(Vector a, Vector b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+    };
+    template <> struct SimdCompare<double>
+    {
+      typedef __m128d Vector;
+      static const int kSize = 2;
+      static Vector Set(double val) { return _mm_set1_pd(val); }
+      static Vector Load(const double* data) { return _mm_loadu_pd(data); }
+      static int Greater(Vector a, Vector b) { return _mm_movemask_pd(_mm_cmpgt_pd(a, b)); }
+    };
+
+    /// SIMD Threshold Filter - Bigger (Greater = true) or smaller elements than the threshold.
+    template <typename T, bool Greater>
+    struct SimdThresholdFilter
+    {
+      typedef SimdCompare<T> Simd;
+      static const int kBlockSize = 16;
+
+      template <typename IT>
+      static bool Any(const IT& it, const T& threshold)
+      {
+        const T* data = &*it;
+        const auto kThreshold = Simd::Set(threshold);
+        int mask = 0;
+        for (int i = 0; i < kBlockSize; i += Simd::kSize)
+          mask |= (Greater) ? Simd::Greater(Simd::Load(data + i), kThreshold)
+                            : Simd::Greater(kThreshold, Simd::Load(data + i));
+        return mask != 0;
+      }
+    };
+
+#define HUC_SIMD_THRESHOLD_FILTER(Type, Comparator, Greater)                                          \
+    template <> struct ThresholdFilter<Type, Comparator<Type>> : SimdThresholdFilter<Type, Greater> {};
+    HUC_SIMD_THRESHOLD_FILTER(int, std::greater_equal, true)
+    HUC_SIMD_THRESHOLD_FILTER(int, std::greater, true)
+    HUC_SIMD_THRESHOLD_FILTER(int, std::less_equal, false)
+    HUC_SIMD_THRESHOLD_FILTER(int, std::less, false)
+    HUC_SIMD_THRESHOLD_FILTER(float, std::greater_equal, true)
+    HUC_SIMD_THRESHOLD_FILTER(float, std::greater, true)
+    HUC_SIMD_THRESHOLD_FILTER(float, std::less_equal, false)
+    HUC_SIMD_THRESHOLD_FILTER(float, std::less, false)
+    HUC_SIMD_THRESHOLD_FILTER(double, std::greater_equal, true)
+    HUC_SIMD_THRESHOLD_FILTER(double, std::greater, true)
+    HUC_SIMD_THRESHOLD_FILTER(double, std::less_equal, false)
+    HUC_SIMD_THRESHOLD_FILTER(double, std::less, false)
+#undef HUC_SIMD_THRESHOLD_FILTER
+#endif
+
+    /// Max M Elements Heap
+    /// Identify the m maximal/minimal values sorted in decreasing/increasing order.
+    ///
+    /// @details Same results as MaxMElements, processed using a binary heap of size m whose top is the
+    /// worst element kept: elements not beating it are discarded in O(1), by blocks on contiguous
+    /// sequences (cf. ThresholdFilter); the others replace the top in O(log(m)).
+    ///
+    /// @tparam Container type used to return the elements.
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Compare functor type.
+    ///
+    /// @param begin,end iterators to the initial and final positions of
+    /// the sequence to be sorted. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param m the numbers of max elements value to be found.
+    ///
+    /// @complexity O(n + k * log(m)) where k is the number of elements entering the heap (O(m * log(n/m))
+    /// on randomly ordered sequences).
+    ///
+    /// @return a vector of sorted in decreasing/increasing order of the m maximum/minimum
+    /// elements, an empty array in case of failure.
+    template <typename Container,
+              typename IT,
+              typename Compare = std::greater_equal<typename std::iterator_traits<IT>::value_type>>
+    Container MaxMElementsHeap(const IT& begin, const IT& end, const int m)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef ThresholdFilter<Value, Compare> Filter;
+      const bool kIsContiguous = std::is_pointer<IT>::value ||
+                                 std::is_same<IT, typename std::vector<Value>::iterator>::value ||
+                                 std::is_same<IT, typename std::vector<Value>::const_iterator>::value;
+
+      if (m < 1 || m > std::distance(begin, end))
+        return Container();
+
+      // Strict ordering deduced from the non-strict Compare: a better than b <=> !(b >= a)
+      auto lBetter = [](const Value& a, const Value& b) { return !Compare()(b, a); };
+
+      // Heap of the m first elements with the worst one on top
+      std::vector<Value> heap(begin, begin + m);
+      std::make_heap(heap.begin(), heap.end(), lBetter);
+      const std::size_t kSize = heap.size();
+      auto lInsert = [&](const Value& val)
+      {
+        if (!lBetter(val, heap.front()))
+          return;
+
+        // Replace the top and sift it down
+        std::size_t i = 0;
+        for (std::size_t child = 1; child < kSize; child = 2 * i + 1)
+        {
+          if (child + 1 < kSize && lBetter(heap[child], heap[child + 1]))
+            ++child;
+          if (!lBetter(val, heap[child]))
+            break;
+          heap[i] = heap[child];
+          i = child;
+        }
+        heap[i] = val;
+      };
+
+      auto it = begin + m;
+      if (kIsContiguous)
+        for (; std::distance(it, end) >= Filter::kBlockSize; it += Filter::kBlockSize)
+        {
+          if (!Filter::Any(it, heap.front()))
+            continue;
+          for (auto blockIt = it; blockIt != it + Filter::kBlockSize; ++blockIt)
+            lInsert(*blockIt);
+        }
+      for (; it != end; ++it)
+        lInsert(*it);
+
+      std::sort_heap(heap.begin(), heap.end(), lBetter);
+      return Container(heap.begin(), heap.end());
+    }
+
+    /// Parallel Max M Elements - Multi-threaded version of MaxMElementsHeap.
+    ///
+    /// @details Each thread finds the m maximal/minimal values of its chunk, these are then merged into
+    /// the m final ones.
+    ///
+    /// @tparam Container type used to return the elements.
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Compare functor type.
+    ///
+    /// @param begin,end iterators to the initial and final positions of
+    /// the sequence to be sorted. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param m the numbers of max elements value to be found.
+    /// @param threads number of threads to be used (hardware concurrency by default).
+    ///
+    /// @return a vector of sorted in decreasing/increasing order of the m maximum/minimum
+    /// elements, an empty array in case of failure.
+    template <typename Container,
+              typename IT,
+              typename Compare = std::greater_equal<typename std::iterator_traits<IT>::value_type>>
+    Container ParallelMaxMElements(const IT& begin, const IT& end, const int m,
+                                   unsigned int threads = std::thread::hardware_concurrency())
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef typename std::iterator_traits<IT>::difference_type Distance;
+
+      const auto kSize = std::distance(begin, end);
+      threads = static_cast<unsigned int>(std::min<Distance>(std::max(1u, threads), kSize / (4 * m + 1)));
+      if (m < 1 || m > kSize || threads < 2)
+        return MaxMElementsHeap<Container, IT, Compare>(begin, end, m);
+
+      // Find the m elements of each chunk
+      const Distance kChunkSize = (kSize + threads - 1) / threads;
+      std::vector<std::vector<Value>> chunksElements(threads);
+      std::vector<std::thread> workers;
+      for (unsigned int t = 0; t < threads; ++t)
+      {
+        const auto chunkBegin = begin + std::min(kSize, t * kChunkSize);
+        const auto chunkEnd = begin + std::min(kSize, (t + 1) * kChunkSize);
+        const auto kChunkM = static_cast<int>(std::min<Distance>(m, std::distance(chunkBegin, chunkEnd)));
+        workers.push_back(std::thread([&chunksElements, t, chunkBegin, chunkEnd, kChunkM]()
+        {
+          chunksElements[t] =
+            MaxMElementsHeap<std::vector<Value>, IT, Compare>(chunkBegin, chunkEnd, kChunkM);
+        }));
+      }
+      for (auto it = workers.begin(); it != workers.end(); ++it)
+        it->join();
+
+      // Merge the chunks elements
+      std::vector<Value> merged;
+      for (auto it = chunksElements.begin(); it != chunksElements.end(); ++it)
+        merged.insert(merged.end(), it->begin(), it->end());
+      return MaxMElementsHeap<Container, typename std::vector<Value>::const_iterator, Compare>
+        (merged.begin(), merged.end(), m);
+    }
   }
 }
 
@@ -21,8 +21,17 @@
 #define MODULE_SEARCH_MAX_SUB_SEQUENCE_HXX
 
 // STD includes
+#include <algorithm>
+#include <functional>
 #include <iterator>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace huc
 {
@@ -84,6 +93,274 @@ namespace huc
 
       return indexes;
     }
+
+    /// Sub Sequence Summary - Reduction of a segment of the sequence for MaxSubSequence.
+    ///
+    /// @details Prefix sums are relative to the segment beginning. Summaries of two consecutive
+    /// segments are combined using an associative operator (cf. CombineSubSequence), so that the summary
+    /// of a whole sequence can be obtained from the summaries of its chunks computed independently.
+    ///
+    /// @tparam T type of the elements.
+    template <typename T>
+    struct SubSequenceSummary
+    {
+      T total;        // Sum of the segment elements
+      T minPrefix;    // Minimal prefix sum (first occurence)
+      int minStart;   // Sub array start associated to the minimal prefix (cf. MaxSubSequence)
+      T maxPrefix;    // Maximal prefix sum (first occurence)
+      int maxEnd;     // Index of the maximal prefix end
+      T best;         // Best sub array value
+      int first;      // Best sub array indexes
+      int second;
+    };
+
+    /// CombineSubSequence - Summary of the concatenation of two consecutive segments.
+    ///
+    /// @details The best sub array either lies within one of the segments, or starts at the left minimal
+    /// prefix and ends at the right maximal one. Ties are solved in favor of the first ending sub array
+    /// and of the first occurence of the minimal prefix, as does the sequential scan.
+    ///
+    /// @tparam T type of the elements.
+    /// @tparam Distance functor type computing the distance between two elements.
+    /// @tparam Compare functor type.
+    ///
+    /// @param left,right summaries of the left and right segments.
+    ///
+    /// @complexity O(1).
+    ///
+    /// @return the summary of the concatenated segments.
+    template <typename T, typename Distance = std::minus<T>, typename Compare = std::greater<T>>
+    SubSequenceSummary<T> CombineSubSequence(const SubSequenceSummary<T>& left,
+                                             const SubSequenceSummary<T>& right)
+    {
+      SubSequenceSummary<T> summary = left;
+      summary.total = left.total + right.total;
+
+      const T kRightMin = left.total + right.minPrefix;
+      if (Compare()(left.minPrefix, kRightMin))
+      {
+        summary.minPrefix = kRightMin;
+        summary.minStart = right.minStart;
+      }
+
+      const T kRightMax = left.total + right.maxPrefix;
+      if (Compare()(kRightMax, left.maxPrefix))
+      {
+        summary.maxPrefix = kRightMax;
+        summary.maxEnd = right.maxEnd;
+      }
+
+      // Best sub array ending within the right segment
+      const T kCrossing = Distance()(kRightMax, left.minPrefix);
+      const bool kUseRight = Compare()(right.best, kCrossing) ||
+                             (!Compare()(kCrossing, right.best) && right.second < right.maxEnd);
+      const T kRightBest = kUseRight ? right.best : kCrossing;
+      if (Compare()(kRightBest, left.best))
+      {
+        summary.best = kRightBest;
+        summary.first = kUseRight ? right.first : left.minStart;
+        summary.second = kUseRight ? right.second : right.maxEnd;
+      }
+
+      return summary;
+    }
+
+    /// Sub Sequence Filter - Check whether the prefix sums of a block stay within [min, min + best]:
+    /// such a block cannot update any value of the scan (cf. SubSequenceScan) and can be skipped.
+    ///
+    /// @remark the SSE2 version is used on contiguous int sequences with the standard functors; other
+    /// types are scanned element by element as the block prefix sums might not be exactly the same.
+    ///
+    /// @tparam T type of the elements.
+    /// @tparam Distance functor type computing the distance between two elements.
+    /// @tparam Compare functor type.
+    template <typename T, typename Distance, typename Compare>
+    struct SubSequenceFilter
+    {
+      static const bool kEnabled = false;
+      static const int kBlockSize = 8;
+
+      template <typename IT>
+      static bool Inside(const IT&, const T&, const T&, const T&, T&) { return false; }
+    };
+
+#if defined(__SSE2__)
+    template <>
+    struct SubSequenceFilter<int, std::minus<int>, std::greater<int>>
+    {
+      static const bool kEnabled = true;
+      static const int kBlockSize = 8;
+
+      template <typename IT>
+      static bool Inside(const IT& it, const int& sum, const int& min, const int& best, int& blockSum)
+      {
+        const int* data = &*it;
+        const auto kLow = _mm_set1_epi32(min);
+        const auto kHigh = _mm_set1_epi32(min + best);
+        auto carry = _mm_set1_epi32(sum);
+        auto outside = _mm_setzero_si128();
+        for (int i = 0; i < kBlockSize; i += 4)
+        {
+          // In register prefix sums of the four values
+          auto prefix = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+          prefix = _mm_add_epi32(prefix, _mm_slli_si128(prefix, 4));
+          prefix = _mm_add_epi32(prefix, _mm_slli_si128(prefix, 8));
+          prefix = _mm_add_epi32(prefix, carry);
+
+          outside = _mm_or_si128(outside, _mm_or_si128(_mm_cmpgt_epi32(kLow, prefix),
+                                                       _mm_cmpgt_epi32(prefix, kHigh)));
+          carry = _mm_shuffle_epi32(prefix, 0xFF);
+        }
+
+        blockSum = _mm_cvtsi128_si32(carry);
+        return _mm_movemask_epi8(outside) == 0;
+      }
+    };
+#endif
+
+    /// Sub Sequence Scan - Summary of the segment [first, last) of the sequence.
+    ///
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Distance functor type computing the distance between two elements.
+    /// @tparam Compare functor type.
+    ///
+    /// @param begin iterator to the initial position of the whole sequence (used for indexes).
+    /// @param first,last iterators to the initial and final positions of the non-empty segment.
+    ///
+    /// @complexity O(n), blocks of elements are skipped using SubSequenceFilter on contiguous sequences.
+    ///
+    /// @return the summary of the segment.
+    template <typename IT,
+              typename Distance = std::minus<typename std::iterator_traits<IT>::value_type>,
+              typename Compare = std::greater<typename std::iterator_traits<IT>::value_type>>
+    SubSequenceSummary<typename std::iterator_traits<IT>::value_type>
+    SubSequenceScan(const IT& begin, const IT& first, const IT& last)
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef SubSequenceFilter<Value, Distance, Compare> Filter;
+      const bool kIsContiguous = std::is_pointer<IT>::value ||
+                                 std::is_same<IT, typename std::vector<Value>::iterator>::value ||
+                                 std::is_same<IT, typename std::vector<Value>::const_iterator>::value;
+
+      SubSequenceSummary<Value> summary;
+      int currentIdx = static_cast<int>(std::distance(begin, first));
+      summary.total = *first;
+      summary.minPrefix = summary.total;
+      summary.minStart = currentIdx + ((*first < 0) ? 1 : 0);
+      summary.maxPrefix = summary.total;
+      summary.maxEnd = currentIdx;
+      summary.best = Distance()(summary.total, summary.total);
+      summary.first = summary.minStart;
+      summary.second = currentIdx;
+
+      auto lUpdate = [&](const IT& it)
+      {
+        summary.total += *it;
+        if (Compare()(summary.minPrefix, summary.total))
+        {
+          summary.minPrefix = summary.total;
+          summary.minStart = currentIdx + ((*it < 0) ? 1 : 0);
+        }
+        if (Compare()(summary.total, summary.maxPrefix))
+        {
+          summary.maxPrefix = summary.total;
+          summary.maxEnd = currentIdx;
+        }
+
+        const auto curMax = Distance()(summary.total, summary.minPrefix);
+        if (Compare()(curMax, summary.best))
+        {
+          summary.best = curMax;
+          summary.first = summary.minStart;
+          summary.second = currentIdx;
+        }
+      };
+
+      auto it = first + 1;
+      ++currentIdx;
+      if (Filter::kEnabled && kIsContiguous)
+        for (; std::distance(it, last) >= Filter::kBlockSize; )
+        {
+          Value blockSum;
+          if (Filter::Inside(it, summary.total, summary.minPrefix, summary.best, blockSum))
+          {
+            summary.total = blockSum;
+            it += Filter::kBlockSize;
+            currentIdx += Filter::kBlockSize;
+            continue;
+          }
+          for (const auto blockEnd = it + Filter::kBlockSize; it != blockEnd; ++it, ++currentIdx)
+            lUpdate(it);
+        }
+      for (; it != last; ++it, ++currentIdx)
+        lUpdate(it);
+
+      return summary;
+    }
+
+    /// Parallel Max Sub Sequence - Multi-threaded version of MaxSubSequence.
+    ///
+    /// @details Each thread computes the summary of its chunk (cf. SubSequenceScan), summaries are then
+    /// combined in order (cf. CombineSubSequence) to get the best sub array of the whole sequence.
+    ///
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Distance functor type computing the distance between two elements.
+    /// @tparam Compare functor type.
+    ///
+    /// @param begin,end iterators to the initial and final positions of
+    /// the sequence to be sorted. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param threads number of threads to be used (hardware concurrency by default).
+    ///
+    /// @warning indexes are the ones of MaxSubSequence on integral values; floating point values sums
+    /// are not computed in the same order and might lead to a different sub array in case of ties.
+    ///
+    /// @return indexes of the array with the maximum/minimum sum, <-1,-1> in case of error.
+    template <typename IT,
+              typename Distance = std::minus<typename std::iterator_traits<IT>::value_type>,
+              typename Compare = std::greater<typename std::iterator_traits<IT>::value_type>>
+    std::pair<int, int> ParallelMaxSubSequence(const IT& begin, const IT& end,
+                                               unsigned int threads = std::thread::hardware_concurrency())
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef typename std::iterator_traits<IT>::difference_type Difference;
+      const Difference kMinChunkSize = 4096;
+
+      const auto kSize = std::distance(begin, end);
+      threads = static_cast<unsigned int>(std::min<Difference>(std::max(1u, threads), kSize / kMinChunkSize));
+      if (threads < 2)
+        return MaxSubSequence<IT, Distance, Compare>(begin, end);
+
+      // Summary of each chunk, the first element being the initial state of the scan
+      const Difference kChunkSize = (kSize - 1 + threads - 1) / threads;
+      std::vector<SubSequenceSummary<Value>> summaries(threads);
+      std::vector<std::thread> workers;
+      for (unsigned int t = 0; t < threads; ++t)
+      {
+        const auto chunkBegin = begin + std::min(kSize, 1 + t * kChunkSize);
+        const auto chunkEnd = begin + std::min(kSize, 1 + (t + 1) * kChunkSize);
+        if (chunkBegin == chunkEnd)
+          break;
+        workers.push_back(std::thread([&summaries, &begin, t, chunkBegin, chunkEnd]()
+        { summaries[t] = SubSequenceScan<IT, Distance, Compare>(begin, chunkBegin, chunkEnd); }));
+      }
+      for (auto it = workers.begin(); it != workers.end(); ++it)
+        it->join();
+
+      SubSequenceSummary<Value> summary;
+      summary.total = *begin;
+      summary.minPrefix = static_cast<Value>(0);
+      summary.minStart = (*begin < 0) ? 1 : 0;
+      summary.maxPrefix = *begin;
+      summary.maxEnd = 0;
+      summary.best = *begin;
+      summary.first = 0;
+      summary.second = 0;
+      for (std::size_t t = 0; t < workers.size(); ++t)
+        summary = CombineSubSequence<Value, Distance, Compare>(summary, summaries[t]);
+
+      return std::pair<int, int>(summary.first, summary.second);
+    }
   }
 }
 
@@ -0,0 +1,185 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_SEARCH_MAX_SUB_SEQUENCE_TREE_HXX
+#define MODULE_SEARCH_MAX_SUB_SEQUENCE_TREE_HXX
+
+#include <Search/max_sub_sequence.hxx>
+
+// STD includes
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  namespace search
+  {
+    /// @class MaxSubSequenceTree
+    ///
+    /// Segment tree answering MaxSubSequence queries on any range of a sequence receiving point updates.
+    /// Each node stores the summary of its segment (cf. SubSequenceSummary): a query combines the
+    /// summaries of O(log(n)) nodes covering the range, an update recomputes the summaries of the
+    /// O(log(n)) ancestors of the updated element.
+    ///
+    /// The tree is stored in a flat array of 2n summaries: leaves are the elements [n, 2n[ and node i is
+    /// the parent of nodes 2i and 2i+1, so that there is no padding and no pointer to follow.
+    ///
+    /// @advantages
+    /// - Range queries and updates in O(log(n)) instead of the O(n) MaxSubSequence scan.
+    /// - Queries return the indexes MaxSubSequence would return on the same range.
+    ///
+    /// @drawbacks
+    /// - Stores a copy of the sequence made of summaries: about 8 times the size of the sequence.
+    ///
+    /// @tparam T type of the elements.
+    /// @tparam Distance functor type computing the distance between two elements.
+    /// @tparam Compare functor type.
+    template <typename T, typename Distance = std::minus<T>, typename Compare = std::greater<T>>
+    class MaxSubSequenceTree
+    {
+      typedef SubSequenceSummary<T> Summary;
+
+    public:
+      /// Build - Construct the tree on the sequence using a bottom-up bulk construction.
+      ///
+      /// @param begin,end - ITs to the initial and final positions of
+      /// the sequence to be used. The range used is [first,last), which contains
+      /// all the elements between first and last, including the element pointed by first but
+      /// not the element pointed by last.
+      ///
+      /// @complexity O(n).
+      ///
+      /// @return Max Sub Sequence Tree pointer to be owned, nullptr if construction failed.
+      template <typename IT>
+      static std::unique_ptr<MaxSubSequenceTree> Build(const IT& begin, const IT& end)
+      {
+        if (begin >= end)
+          return nullptr;
+
+        const auto kSize = static_cast<std::size_t>(std::distance(begin, end));
+        auto tree = std::unique_ptr<MaxSubSequenceTree>(new MaxSubSequenceTree(kSize));
+        int index = 0;
+        for (auto it = begin; it != end; ++it, ++index)
+          tree->nodes[kSize + index] = Leaf(index, *it);
+        for (auto node = kSize - 1; node > 0; --node)
+          tree->nodes[node] = CombineSubSequence<T, Distance, Compare>(tree->nodes[2 * node],
+                                                                       tree->nodes[2 * node + 1]);
+
+        return tree;
+      }
+
+      /// Query the sub array with the maximum/minimum sum within [first, last].
+      ///
+      /// @param first,last indexes of the first and last elements of the range.
+      ///
+      /// @complexity O(log(n)).
+      ///
+      /// @return indexes of the array with the maximum/minimum sum (same as MaxSubSequence on the range),
+      /// <-1,-1> in case of error.
+      std::pair<int, int> Query(std::size_t first, std::size_t last) const
+      {
+        if (first >= last || last >= this->size)
+          return std::pair<int, int>(-1, -1);
+
+        // Initial state of the scan: first element as best sub array, empty prefix as minimum
+        const auto& kFirst = this->nodes[this->size + first];
+        Summary summary = kFirst;
+        summary.minPrefix = static_cast<T>(0);
+        summary.minStart = (kFirst.total < 0) ? static_cast<int>(first) + 1 : static_cast<int>(first);
+        summary.best = kFirst.total;
+        summary.first = static_cast<int>(first);
+
+        // Summaries on the left and right sides are combined separately to keep their order
+        Summary rightSummary;
+        bool hasRight = false;
+        for (auto low = this->size + first + 1, high = this->size + last + 1; low < high; low /= 2, high /= 2)
+        {
+          if (low & 1)
+            summary = CombineSubSequence<T, Distance, Compare>(summary, this->nodes[low++]);
+          if (high & 1)
+          {
+            const auto& kNode = this->nodes[--high];
+            rightSummary = hasRight ? CombineSubSequence<T, Distance, Compare>(kNode, rightSummary) : kNode;
+            hasRight = true;
+          }
+        }
+        if (hasRight)
+          summary = CombineSubSequence<T, Distance, Compare>(summary, rightSummary);
+
+        return std::pair<int, int>(summary.first, summary.second);
+      }
+
+      /// Update the value of an element.
+      ///
+      /// @param index index of the element to be updated.
+      /// @param value new value of the element.
+      ///
+      /// @complexity O(log(n)).
+      ///
+      /// @return false if the index is out of range, true otherwise.
+      bool Update(std::size_t index, const T& value)
+      {
+        if (index >= this->size)
+          return false;
+
+        auto node = this->size + index;
+        this->nodes[node] = Leaf(static_cast<int>(index), value);
+        for (node /= 2; node > 0; node /= 2)
+          this->nodes[node] = CombineSubSequence<T, Distance, Compare>(this->nodes[2 * node],
+                                                                       this->nodes[2 * node + 1]);
+
+        return true;
+      }
+
+      /// @return the value of the element at index (undefined behavior if out of range).
+      const T& Get(std::size_t index) const { return this->nodes[this->size + index].total; }
+
+      /// @return the number of elements of the sequence.
+      std::size_t Size() const { return this->size; }
+
+    private:
+      MaxSubSequenceTree(std::size_t size) : size(size), nodes(2 * size) {}
+      MaxSubSequenceTree(MaxSubSequenceTree&) {}           // Not Implemented
+      MaxSubSequenceTree operator=(MaxSubSequenceTree&) {} // Not Implemented
+
+      /// Leaf - Summary of the single element segment (cf. SubSequenceScan).
+      static Summary Leaf(int index, const T& value)
+      {
+        Summary leaf;
+        leaf.total = value;
+        leaf.minPrefix = value;
+        leaf.minStart = index + ((value < 0) ? 1 : 0);
+        leaf.maxPrefix = value;
+        leaf.maxEnd = index;
+        leaf.best = Distance()(value, value);
+        leaf.first = leaf.minStart;
+        leaf.second = index;
+        return leaf;
+      }
+
+      std::size_t size;            // Number of elements of the sequence
+      std::vector<Summary> nodes;  // Flat tree: root [1], children of i [2i, 2i+1], leaves [size, 2size[
+    };
+  }
+}
+
+#endif // MODULE_SEARCH_MAX_SUB_SEQUENCE_TREE_HXX
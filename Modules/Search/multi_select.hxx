@@ -0,0 +1,280 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_SEARCH_MULTI_SELECT_HXX
+#define MODULE_SEARCH_MULTI_SELECT_HXX
+
+#include <Search/intro_select.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace huc
+{
+  namespace search
+  {
+    /// Multi Select Sorted - Place the elements of several ranks at their sorted position.
+    ///
+    /// @details The middle rank is selected first, partitioning the sequence in two: each half is then
+    /// processed only with the ranks it contains.
+    ///
+    /// @warning ranks are not checked: they have to be sorted, unique and within the sequence.
+    ///
+    /// @tparam IT Random-access iterator type.
+    /// @tparam RankIT Random-access iterator type on the ranks.
+    /// @tparam Compare functor type (std::less_equal to find smallest elements,
+    /// std::greater_equal to find the biggest ones).
+    ///
+    /// @param begin,end - ITs to the initial and final positions of the sequence.
+    /// @param ranksBegin,ranksEnd - ITs on the zero-based ranks to be selected, relative to begin.
+    ///
+    /// @complexity O(n * log(q)) for q ranks.
+    ///
+    /// @return void.
+    template <typename IT,
+              typename RankIT,
+              typename Compare = std::less_equal<typename std::iterator_traits<IT>::value_type>>
+    void MultiSelectSorted(const IT& begin, const IT& end, const RankIT& ranksBegin, const RankIT& ranksEnd)
+    {
+      if (ranksBegin >= ranksEnd)
+        return;
+
+      const auto kMiddleRank = ranksBegin + std::distance(ranksBegin, ranksEnd) / 2;
+      const auto kth = IntroSelect<IT, Compare>(begin, end, *kMiddleRank);
+
+      // Shift right side ranks relative to its new beginning
+      std::vector<unsigned int> rightRanks(kMiddleRank + 1, ranksEnd);
+      for (auto it = rightRanks.begin(); it != rightRanks.end(); ++it)
+        *it -= *kMiddleRank + 1;
+
+      MultiSelectSorted<IT, RankIT, Compare>(begin, kth, ranksBegin, kMiddleRank);
+      MultiSelectSorted<IT, std::vector<unsigned int>::iterator, Compare>
+        (kth + 1, end, rightRanks.begin(), rightRanks.end());
+    }
+
+    /// Multi Select - Find several order statistics (e.g. percentiles) of the sequence at once.
+    ///
+    /// @remark calling KthOrderStatistic for each rank processes the whole sequence q times, while the
+    /// partitions done to find a rank are here reused to find the others.
+    ///
+    /// @warning this method changes the elements order between your iterators: each selected element is
+    /// at its sorted position, with smaller/bigger (or equal) elements before and bigger/smaller after.
+    ///
+    /// @tparam IT Random-access iterator type.
+    /// @tparam Compare functor type (std::less_equal to find smallest elements,
+    /// std::greater_equal to find the biggest ones).
+    ///
+    /// @param begin,end - ITs to the initial and final positions of
+    /// the sequence. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param ks the zero-based ranks to be found, in any order.
+    ///
+    /// @complexity O(n * log(q)) for q ranks.
+    ///
+    /// @return the ITs on the kth elements in the order of ks, the end IT for ranks out of the sequence.
+    template <typename IT, typename Compare = std::less_equal<typename std::iterator_traits<IT>::value_type>>
+    std::vector<IT> MultiSelect(const IT& begin, const IT& end, const std::vector<unsigned int>& ks)
+    {
+      const auto kSize = std::distance(begin, end);
+
+      // Sorted unique ranks within the sequence
+      std::vector<unsigned int> ranks;
+      for (auto it = ks.begin(); it != ks.end(); ++it)
+        if (kSize > 0 && *it < static_cast<unsigned int>(kSize))
+          ranks.push_back(*it);
+      std::sort(ranks.begin(), ranks.end());
+      ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+      MultiSelectSorted<IT, std::vector<unsigned int>::iterator, Compare>
+        (begin, end, ranks.begin(), ranks.end());
+
+      std::vector<IT> kths;
+      kths.reserve(ks.size());
+      for (auto it = ks.begin(); it != ks.end(); ++it)
+        kths.push_back((kSize > 0 && *it < static_cast<unsigned int>(kSize)) ? begin + *it : end);
+      return kths;
+    }
+
+    /// Parallel Multi Select - Multi-threaded version of MultiSelect.
+    ///
+    /// @details The first partition levels are replaced by a unique parallel pass:
+    /// - Splitters are taken from a sorted sample, tightly around the expected position of each rank.
+    /// - Each thread counts then scatters its chunk into buckets delimited by the splitters (elements
+    ///   equivalent to a splitter get their own bucket), using a buffer of the sequence size.
+    /// - Buckets containing ranks are finally processed by MultiSelect concurrently.
+    ///
+    /// @warning this method changes the elements order between your iterators (cf. MultiSelect).
+    ///
+    /// @tparam IT Random-access iterator type.
+    /// @tparam Compare functor type (std::less_equal to find smallest elements,
+    /// std::greater_equal to find the biggest ones).
+    ///
+    /// @param begin,end - ITs to the initial and final positions of
+    /// the sequence. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param ks the zero-based ranks to be found, in any order.
+    /// @param threads number of threads to be used (hardware concurrency by default).
+    ///
+    /// @complexity O(n / threads + n * log(q) / (threads * sqrt(sample))).
+    ///
+    /// @return the ITs on the kth elements in the order of ks, the end IT for ranks out of the sequence.
+    template <typename IT, typename Compare = std::less_equal<typename std::iterator_traits<IT>::value_type>>
+    std::vector<IT> ParallelMultiSelect(const IT& begin, const IT& end, const std::vector<unsigned int>& ks,
+                                        unsigned int threads = std::thread::hardware_concurrency())
+    {
+      typedef typename std::iterator_traits<IT>::value_type Value;
+      typedef typename std::iterator_traits<IT>::difference_type Distance;
+      const Distance kMinChunkSize = 1 << 14; // Smaller chunks are not worth a thread
+
+      const auto kSize = std::distance(begin, end);
+      threads = static_cast<unsigned int>(std::min<Distance>(std::max(1u, threads), kSize / kMinChunkSize));
+      if (threads < 2 || ks.empty())
+        return MultiSelect<IT, Compare>(begin, end, ks);
+
+      std::vector<unsigned int> ranks;
+      for (auto it = ks.begin(); it != ks.end(); ++it)
+        if (*it < static_cast<unsigned int>(kSize))
+          ranks.push_back(*it);
+      std::sort(ranks.begin(), ranks.end());
+      ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+      // Strict ordering and equivalence deduced from the non-strict Compare
+      auto lLess = [](const Value& a, const Value& b) { return !Compare()(b, a); };
+
+      // Splitters - sample values framing the expected position of each rank
+      const Distance kSampleSize = std::min<Distance>(kSize, 1 << 12);
+      const Distance kMargin = static_cast<Distance>(std::sqrt(static_cast<double>(kSampleSize)));
+      std::vector<Value> sample;
+      sample.reserve(kSampleSize);
+      for (Distance i = 0; i < kSampleSize; ++i)
+        sample.push_back(*(begin + i * (kSize / kSampleSize)));
+      std::sort(sample.begin(), sample.end(), lLess);
+
+      std::vector<Value> splitters;
+      for (auto it = ranks.begin(); it != ranks.end(); ++it)
+      {
+        const auto kExpected = static_cast<Distance>(static_cast<double>(*it) / kSize * kSampleSize);
+        splitters.push_back(sample[std::max<Distance>(0, kExpected - kMargin)]);
+        splitters.push_back(sample[std::min<Distance>(kSampleSize - 1, kExpected + kMargin)]);
+      }
+      std::sort(splitters.begin(), splitters.end(), lLess);
+      splitters.erase(std::unique(splitters.begin(), splitters.end(),
+                                  [&lLess](const Value& a, const Value& b) { return !lLess(a, b); }),
+                      splitters.end());
+
+      // Bucket 2j: elements between splitters j-1 and j - Bucket 2j+1: elements equivalent to splitter j
+      const std::size_t kBucketCount = 2 * splitters.size() + 1;
+      auto lBucket = [&splitters, &lLess](const Value& val)
+      {
+        const auto it = std::lower_bound(splitters.begin(), splitters.end(), val, lLess);
+        const auto j = static_cast<std::size_t>(std::distance(splitters.begin(), it));
+        return (it != splitters.end() && !lLess(val, *it)) ? 2 * j + 1 : 2 * j;
+      };
+
+      // Run the function on each thread chunk concurrently
+      const Distance kChunkSize = (kSize + threads - 1) / threads;
+      auto lRunChunks = [&](const std::function<void(unsigned int, IT, IT)>& function)
+      {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; ++t)
+        {
+          const auto chunkBegin = begin + std::min(kSize, t * kChunkSize);
+          const auto chunkEnd = begin + std::min(kSize, (t + 1) * kChunkSize);
+          workers.push_back(std::thread(function, t, chunkBegin, chunkEnd));
+        }
+        for (auto it = workers.begin(); it != workers.end(); ++it)
+          it->join();
+      };
+
+      // Count bucket sizes per chunk
+      std::vector<std::vector<Distance>> offsets(threads, std::vector<Distance>(kBucketCount, 0));
+      lRunChunks([&](unsigned int t, IT chunkBegin, IT chunkEnd)
+      {
+        for (auto it = chunkBegin; it != chunkEnd; ++it)
+          ++offsets[t][lBucket(*it)];
+      });
+
+      // Exclusive prefix sums give each chunk its writing position within each bucket
+      std::vector<Distance> bucketBegins(kBucketCount + 1, 0);
+      Distance position = 0;
+      for (std::size_t b = 0; b < kBucketCount; ++b)
+      {
+        bucketBegins[b] = position;
+        for (unsigned int t = 0; t < threads; ++t)
+        {
+          const auto count = offsets[t][b];
+          offsets[t][b] = position;
+          position += count;
+        }
+      }
+      bucketBegins[kBucketCount] = position;
+
+      // Scatter to the buffer then copy back
+      std::vector<Value> buffer(kSize);
+      lRunChunks([&](unsigned int t, IT chunkBegin, IT chunkEnd)
+      {
+        for (auto it = chunkBegin; it != chunkEnd; ++it)
+          buffer[offsets[t][lBucket(*it)]++] = *it;
+      });
+      lRunChunks([&](unsigned int, IT chunkBegin, IT chunkEnd)
+      { std::copy(buffer.begin() + (chunkBegin - begin), buffer.begin() + (chunkEnd - begin), chunkBegin); });
+
+      // Distribute the buckets containing ranks (equivalent buckets are already sorted) between threads
+      std::vector<std::pair<std::size_t, std::vector<unsigned int>>> jobs;
+      for (auto it = ranks.begin(); it != ranks.end(); ++it)
+      {
+        const auto b = static_cast<std::size_t>(std::distance(bucketBegins.begin(),
+          std::upper_bound(bucketBegins.begin(), bucketBegins.end(), static_cast<Distance>(*it))) - 1);
+        if (b % 2 == 1)
+          continue;
+        if (jobs.empty() || jobs.back().first != b)
+          jobs.push_back(std::make_pair(b, std::vector<unsigned int>()));
+        jobs.back().second.push_back(*it - static_cast<unsigned int>(bucketBegins[b]));
+      }
+
+      std::vector<std::thread> workers;
+      for (unsigned int t = 0; t < std::min<std::size_t>(threads, jobs.size()); ++t)
+        workers.push_back(std::thread([&, t]()
+        {
+          for (std::size_t j = t; j < jobs.size(); j += threads)
+          {
+            const auto& job = jobs[j];
+            MultiSelectSorted<IT, std::vector<unsigned int>::const_iterator, Compare>
+              (begin + bucketBegins[job.first], begin + bucketBegins[job.first + 1],
+               job.second.begin(), job.second.end());
+          }
+        }));
+      for (auto it = workers.begin(); it != workers.end(); ++it)
+        it->join();
+
+      std::vector<IT> kths;
+      kths.reserve(ks.size());
+      for (auto it = ks.begin(); it != ks.end(); ++it)
+        kths.push_back((*it < static_cast<unsigned int>(kSize)) ? begin + *it : end);
+      return kths;
+    }
+  }
+}
+
+#endif // MODULE_SEARCH_MULTI_SELECT_HXX
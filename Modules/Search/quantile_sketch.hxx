@@ -0,0 +1,214 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_SEARCH_QUANTILE_SKETCH_HXX
+#define MODULE_SEARCH_QUANTILE_SKETCH_HXX
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace huc
+{
+  namespace search
+  {
+    /// @class QuantileSketch
+    ///
+    /// A KLL (Karnin, Lang, Liberty) sketch answering approximate rank and quantile queries over a stream
+    /// of elements using a bounded memory, where KthOrderStatistic needs the whole sequence.
+    ///
+    /// Elements are stored within a hierarchy of compactors: an element at level h stands for 2^h elements
+    /// of the stream. When a level is full, it is sorted and one element out of two (randomly the odd or
+    /// even ones) is promoted to the next level, the others being discarded. Level capacities decrease
+    /// geometrically (factor 2/3) from the top level, whose capacity is k.
+    ///
+    /// @advantages
+    /// - Memory in O(k) whatever the stream length; rank error in O(1/k) (under 1% for k = 200).
+    /// - Sketches are mergeable: streams can be processed by several threads and their sketches merged.
+    /// - Elements only need to be comparable (no arithmetic as for t-digest).
+    ///
+    /// @drawbacks
+    /// - Answers are approximate and randomized.
+    ///
+    /// @tparam T type of the elements.
+    /// @tparam Compare strict ordering functor type.
+    template <typename T, typename Compare = std::less<T>>
+    class QuantileSketch
+    {
+    public:
+      /// Create an empty sketch.
+      ///
+      /// @param k accuracy parameter: capacity of the top level (minimum 8).
+      /// @param seed seed of the generator choosing the promoted elements.
+      explicit QuantileSketch(unsigned int k = 200, unsigned int seed = 5489u) :
+        k(std::max(8u, k)), count(0), generator(seed), levels(1) {}
+
+      /// Insert an element.
+      ///
+      /// @complexity O(1) amortized, O(k * log(k)) when compacting.
+      void Insert(const T& value)
+      {
+        this->levels[0].push_back(value);
+        ++this->count;
+        if (this->levels[0].size() >= this->Capacity(0))
+          this->Compress();
+      }
+
+      /// Insert a batch of elements.
+      ///
+      /// @param begin,end - iterators to the initial and final positions of
+      /// the sequence. The range used is [first,last), which contains all the elements between
+      /// first and last, including the element pointed by first but not the element pointed by last.
+      template <typename IT>
+      void Insert(const IT& begin, const IT& end)
+      {
+        for (auto it = begin; it != end;)
+        {
+          // Fill the first level up to its capacity at once
+          auto& level = this->levels[0];
+          const auto kFree = static_cast<std::ptrdiff_t>(this->Capacity(0) - std::min(this->Capacity(0),
+                                                                                      level.size()));
+          auto batchEnd = it;
+          for (std::ptrdiff_t i = 0; i < kFree && batchEnd != end; ++i)
+            ++batchEnd;
+          level.insert(level.end(), it, batchEnd);
+          this->count += static_cast<std::size_t>(std::distance(it, batchEnd));
+          it = batchEnd;
+
+          if (level.size() >= this->Capacity(0))
+            this->Compress();
+        }
+      }
+
+      /// Merge another sketch into this one: the result summarizes both streams.
+      ///
+      /// @complexity O(k * log(k)).
+      void Merge(const QuantileSketch& other)
+      {
+        if (other.levels.size() > this->levels.size())
+          this->levels.resize(other.levels.size());
+        for (std::size_t h = 0; h < other.levels.size(); ++h)
+          this->levels[h].insert(this->levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+        this->count += other.count;
+        this->Compress();
+      }
+
+      /// Approximate rank of a value: number of elements of the stream strictly lower than the value.
+      ///
+      /// @complexity O(k).
+      std::size_t Rank(const T& value) const
+      {
+        std::size_t rank = 0;
+        for (std::size_t h = 0; h < this->levels.size(); ++h)
+          for (auto it = this->levels[h].begin(); it != this->levels[h].end(); ++it)
+            if (Compare()(*it, value))
+              rank += std::size_t(1) << h;
+        return rank;
+      }
+
+      /// Approximate quantile: element whose zero-based rank within the stream is close to q * Count().
+      ///
+      /// @param q normalized rank in [0, 1].
+      ///
+      /// @complexity O(k * log(k)).
+      ///
+      /// @return element of the stream (default value for an empty sketch).
+      T Quantile(double q) const
+      {
+        if (this->count == 0)
+          return T();
+
+        // Sorted elements with their weight
+        std::vector<std::pair<T, std::size_t>> weighted;
+        for (std::size_t h = 0; h < this->levels.size(); ++h)
+          for (auto it = this->levels[h].begin(); it != this->levels[h].end(); ++it)
+            weighted.push_back(std::make_pair(*it, std::size_t(1) << h));
+        std::sort(weighted.begin(), weighted.end(),
+                  [](const std::pair<T, std::size_t>& a, const std::pair<T, std::size_t>& b)
+                  { return Compare()(a.first, b.first); });
+
+        // First element whose cumulative weight goes beyond the rank
+        const auto kRank = static_cast<std::size_t>(std::max(0., std::min(1., q)) * (this->count - 1));
+        std::size_t cumulative = 0;
+        for (auto it = weighted.begin(); it != weighted.end(); ++it)
+          if ((cumulative += it->second) > kRank)
+            return it->first;
+        return weighted.back().first;
+      }
+
+      /// @return the number of elements inserted within the sketch.
+      std::size_t Count() const { return this->count; }
+
+      /// @return the number of elements retained by the sketch.
+      std::size_t GetRetainedCount() const
+      {
+        std::size_t retained = 0;
+        for (auto it = this->levels.begin(); it != this->levels.end(); ++it)
+          retained += it->size();
+        return retained;
+      }
+
+      /// @return the accuracy parameter.
+      unsigned int GetK() const { return this->k; }
+
+    private:
+      /// Capacity of a level: k for the top one, decreasing by a factor 2/3 for each lower level.
+      std::size_t Capacity(std::size_t h) const
+      {
+        const auto kDepth = static_cast<double>(this->levels.size() - 1 - h);
+        const auto kCapacity = std::ceil(this->k * std::pow(2. / 3., kDepth));
+        return std::max<std::size_t>(2, static_cast<std::size_t>(kCapacity));
+      }
+
+      /// Compact the full levels until the sketch fits its capacity.
+      void Compress()
+      {
+        for (std::size_t h = 0; h < this->levels.size(); ++h)
+        {
+          if (this->levels[h].size() < this->Capacity(h))
+            continue;
+
+          if (h + 1 == this->levels.size())
+            this->levels.push_back(std::vector<T>());
+          auto& level = this->levels[h];
+          auto& upper = this->levels[h + 1];
+
+          // Promote one sorted element out of two, keeping the first one back on odd sizes
+          std::sort(level.begin(), level.end(), Compare());
+          const std::size_t kKept = level.size() % 2;
+          for (std::size_t i = kKept + (this->generator() & 1); i < level.size(); i += 2)
+            upper.push_back(level[i]);
+          level.resize(kKept);
+        }
+      }
+
+      unsigned int k;                       // Accuracy parameter
+      std::size_t count;                    // Number of elements inserted
+      std::minstd_rand generator;           // Generator choosing the promoted elements
+      std::vector<std::vector<T>> levels;   // Compactors - elements of level h weight 2^h
+    };
+  }
+}
+
+#endif // MODULE_SEARCH_QUANTILE_SKETCH_HXX
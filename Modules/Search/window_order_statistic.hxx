@@ -0,0 +1,263 @@
+/*===========================================================================================================
+ *
+ * HUC - Hurna Core
+ *
+ * Copyright (c) Michael Jeulin-Lagarrigue
+ *
+ *  Licensed under the MIT License, you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://github.com/Hurna/Hurna-Core/blob/master/LICENSE
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and limitations under the License.
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ *=========================================================================================================*/
+#ifndef MODULE_SEARCH_WINDOW_ORDER_STATISTIC_HXX
+#define MODULE_SEARCH_WINDOW_ORDER_STATISTIC_HXX
+
+// STD includes
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace huc
+{
+  namespace search
+  {
+    /// @class WindowOrderStatistic
+    ///
+    /// Order statistics (kth element, quantiles, ranks) over the last W elements of a stream, where
+    /// KthOrderStatistic needs a copy of the window on each query.
+    ///
+    /// Elements of the window are stored within a treap (binary search tree whose nodes also respect a
+    /// heap order on random priorities) augmented by subtree sizes: selecting the kth element only follows
+    /// the sizes from the root. Nodes are stored in a contiguous array of W slots linked by 32 bits indexes:
+    /// the element pushed at time t uses the slot t % W, freed by the element leaving the window.
+    ///
+    /// @advantages
+    /// - Push and queries for any rank in O(log(W)) (expected).
+    /// - Memory allocated once, no pointer: W nodes of size sizeof(T) + 16 bytes.
+    ///
+    /// @drawbacks
+    /// - Queries are answered in O(log(W)) when two heaps would answer a fixed rank one in O(1).
+    ///
+    /// @tparam T type of the elements.
+    /// @tparam Compare strict ordering functor type.
+    template <typename T, typename Compare = std::less<T>>
+    class WindowOrderStatistic
+    {
+      /// Node - Element of the window, nil being the node 0.
+      struct Node
+      {
+        T value;
+        std::uint32_t left;
+        std::uint32_t right;
+        std::uint32_t size;      // Number of nodes within the subtree
+        std::uint32_t priority;  // Heap order: a parent priority is greater or equal than its children ones
+      };
+
+    public:
+      /// Create an empty window.
+      ///
+      /// @param window number of elements W kept in the window (1 at least).
+      /// @param seed seed of the generator drawing the nodes priorities.
+      explicit WindowOrderStatistic(std::size_t window, unsigned int seed = 5489u) :
+        window(std::max<std::size_t>(1, window)), count(0), root(0), generator(seed), nodes(this->window + 1)
+      { this->nodes[0].left = this->nodes[0].right = this->nodes[0].size = this->nodes[0].priority = 0; }
+
+      /// Push a new element, the oldest element is removed from the window if full.
+      ///
+      /// @param value the element to be pushed.
+      ///
+      /// @complexity O(log(W)) expected.
+      void Push(const T& value)
+      {
+        const auto kSlot = static_cast<std::uint32_t>(1 + this->count % this->window);
+        if (this->count >= this->window)
+          this->root = this->Erase(this->root, kSlot);
+
+        auto& node = this->nodes[kSlot];
+        node.value = value;
+        node.left = node.right = 0;
+        node.size = 1;
+        node.priority = static_cast<std::uint32_t>(this->generator());
+        this->root = this->Insert(this->root, kSlot);
+        ++this->count;
+      }
+
+      /// Select the kth smallest element of the window.
+      ///
+      /// @param k the zero-based kth element - 0 for the smallest.
+      ///
+      /// @complexity O(log(W)) expected.
+      ///
+      /// @return the kth element of the window (default value if k is out of range).
+      T Select(std::size_t k) const
+      {
+        if (k >= this->Size())
+          return T();
+
+        auto node = this->root;
+        while (true)
+        {
+          const std::size_t kLeftSize = this->nodes[this->nodes[node].left].size;
+          if (k == kLeftSize)
+            return this->nodes[node].value;
+
+          if (k < kLeftSize)
+            node = this->nodes[node].left;
+          else
+          {
+            k -= kLeftSize + 1;
+            node = this->nodes[node].right;
+          }
+        }
+      }
+
+      /// Quantile: element whose zero-based rank within the window is q * (Size() - 1) (rounded down).
+      ///
+      /// @param q normalized rank in [0, 1].
+      ///
+      /// @complexity O(log(W)) expected.
+      ///
+      /// @return element of the window (default value for an empty window).
+      T Quantile(double q) const
+      {
+        if (this->Size() == 0)
+          return T();
+        return this->Select(static_cast<std::size_t>(std::max(0., std::min(1., q)) * (this->Size() - 1)));
+      }
+
+      /// Rank: number of elements of the window strictly lower than the value.
+      ///
+      /// @param value the value to be ranked.
+      ///
+      /// @complexity O(log(W)) expected.
+      std::size_t Rank(const T& value) const
+      {
+        std::size_t rank = 0;
+        for (auto node = this->root; node != 0; )
+          if (Compare()(this->nodes[node].value, value))
+          {
+            rank += this->nodes[this->nodes[node].left].size + 1;
+            node = this->nodes[node].right;
+          }
+          else
+            node = this->nodes[node].left;
+        return rank;
+      }
+
+      /// @return the number of elements pushed.
+      std::size_t Count() const { return this->count; }
+
+      /// @return the number of elements within the window.
+      std::size_t Size() const { return this->nodes[this->root].size; }
+
+    private:
+      /// Strict order on the nodes: by value, then by slot for equal values.
+      bool Less(std::uint32_t a, std::uint32_t b) const
+      {
+        if (Compare()(this->nodes[a].value, this->nodes[b].value))
+          return true;
+        return !Compare()(this->nodes[b].value, this->nodes[a].value) && a < b;
+      }
+
+      void UpdateSize(std::uint32_t node)
+      {
+        this->nodes[node].size =
+          this->nodes[this->nodes[node].left].size + this->nodes[this->nodes[node].right].size + 1;
+      }
+
+      /// Insert the slot within the subtree, rotating it up while its priority is the greatest one.
+      /// @return the new root of the subtree.
+      std::uint32_t Insert(std::uint32_t node, std::uint32_t slot)
+      {
+        if (node == 0)
+          return slot;
+
+        auto& current = this->nodes[node];
+        if (this->Less(slot, node))
+        {
+          current.left = this->Insert(current.left, slot);
+          if (this->nodes[current.left].priority > current.priority)
+          {
+            // Right rotation
+            const auto kChild = current.left;
+            current.left = this->nodes[kChild].right;
+            this->nodes[kChild].right = node;
+            this->UpdateSize(node);
+            this->UpdateSize(kChild);
+            return kChild;
+          }
+        }
+        else
+        {
+          current.right = this->Insert(current.right, slot);
+          if (this->nodes[current.right].priority > current.priority)
+          {
+            // Left rotation
+            const auto kChild = current.right;
+            current.right = this->nodes[kChild].left;
+            this->nodes[kChild].left = node;
+            this->UpdateSize(node);
+            this->UpdateSize(kChild);
+            return kChild;
+          }
+        }
+
+        this->UpdateSize(node);
+        return node;
+      }
+
+      /// Erase the slot from the subtree, replacing it by the merge of its children.
+      /// @return the new root of the subtree.
+      std::uint32_t Erase(std::uint32_t node, std::uint32_t slot)
+      {
+        if (node == slot)
+          return this->Merge(this->nodes[node].left, this->nodes[node].right);
+
+        auto& current = this->nodes[node];
+        if (this->Less(slot, node))
+          current.left = this->Erase(current.left, slot);
+        else
+          current.right = this->Erase(current.right, slot);
+        --current.size;
+        return node;
+      }
+
+      /// Merge two subtrees, all the nodes of the left one being lower than the right ones.
+      /// @return the root of the merged subtree.
+      std::uint32_t Merge(std::uint32_t left, std::uint32_t right)
+      {
+        if (left == 0 || right == 0)
+          return left + right;
+
+        if (this->nodes[left].priority > this->nodes[right].priority)
+        {
+          this->nodes[left].right = this->Merge(this->nodes[left].right, right);
+          this->UpdateSize(left);
+          return left;
+        }
+
+        this->nodes[right].left = this->Merge(left, this->nodes[right].left);
+        this->UpdateSize(right);
+        return right;
+      }
+
+      std::size_t window;          // Maximal number of elements W within the window
+      std::size_t count;           // Number of elements pushed
+      std::uint32_t root;          // Root node of the treap (0 when empty)
+      std::minstd_rand generator;  // Generator drawing the nodes priorities
+      std::vector<Node> nodes;     // Nodes [1, W] of the treap, node 0 being nil
+    };
+  }
+}
+
+#endif // MODULE_SEARCH_WINDOW_ORDER_STATISTIC_HXX
@@ -196,3 +196,59 @@ TEST(TestPartition, PartitionGreaterComparator)
     CheckPartition<std::string::iterator>(randomStr.begin(), randomStr.end(), newPivot, pivotVal, false);
   }
 }
+
+// Three-Way Partition tests
+TEST(TestPartition, ThreeWayPartitions)
+{
+  // Normal Run - Random Array with duplicates - Should result in: [begin, first[ < pivot,
+  // [first, second[ == pivot and [second, end[ > pivot
+  {
+    Container randomdArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    auto pivot = randomdArray.begin() + 1;
+    const auto pivotVal = *pivot;
+
+    auto bounds = ThreeWayPartition<IT>(randomdArray.begin(), pivot, randomdArray.end());
+    EXPECT_EQ(3, std::distance(bounds.first, bounds.second));
+    for (auto it = randomdArray.begin(); it < bounds.first; ++it)
+      EXPECT_GT(pivotVal, *it);
+    for (auto it = bounds.first; it < bounds.second; ++it)
+      EXPECT_EQ(pivotVal, *it);
+    for (auto it = bounds.second; it < randomdArray.end(); ++it)
+      EXPECT_LT(pivotVal, *it);
+  }
+
+  // Greater comparator - Should result in: [begin, first[ > pivot, [second, end[ < pivot
+  {
+    Container randomdArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    auto pivot = randomdArray.begin();
+    const auto pivotVal = *pivot;
+
+    auto bounds = ThreeWayPartition<IT, GE_Compare>(randomdArray.begin(), pivot, randomdArray.end());
+    EXPECT_EQ(2, std::distance(bounds.first, bounds.second));
+    for (auto it = randomdArray.begin(); it < bounds.first; ++it)
+      EXPECT_LT(pivotVal, *it);
+    for (auto it = bounds.second; it < randomdArray.end(); ++it)
+      EXPECT_GT(pivotVal, *it);
+  }
+
+  // Same elements - The whole sequence should be equivalent to the pivot
+  {
+    Container sameElementArray(10, 2);
+    auto bounds = ThreeWayPartition<IT>(sameElementArray.begin(), sameElementArray.begin() + 3,
+                                        sameElementArray.end());
+    EXPECT_EQ(sameElementArray.begin(), bounds.first);
+    EXPECT_EQ(sameElementArray.end(), bounds.second);
+  }
+
+  // Pivot choose as end - cannot process
+  {
+    Container randomdArray(RandomArrayInt, RandomArrayInt + sizeof(RandomArrayInt) / sizeof(int));
+    auto bounds = ThreeWayPartition<IT>(randomdArray.begin(), randomdArray.end(), randomdArray.end());
+    EXPECT_EQ(randomdArray.end(), bounds.first);
+    EXPECT_EQ(randomdArray.end(), bounds.second);
+
+    int i = 0;
+    for (auto it = randomdArray.begin(); it < randomdArray.end(); ++it, ++i)
+      EXPECT_EQ(RandomArrayInt[i], *it);
+  }
+}
@@ -22,6 +22,7 @@
 
 // STD includes
 #include <iterator>
+#include <utility>
 
 namespace huc
 {
@@ -64,6 +65,47 @@ namespace huc
 
       return store;
     }
+
+    /// Three-Way Partition - Proceed an in-place patitionning of the elements into three sequences: elements
+    /// strictly before the pivot, elements equivalent to the pivot and elements strictly after the pivot.
+    ///
+    /// @remark Known as the Dutch National Flag problem: contrary to Partition, sequences containing many
+    /// duplicates are split in a unique pass and the equivalent elements do not have to be processed again.
+    ///
+    /// @tparam IT type using to go through the collection.
+    /// @tparam Compare functor type (std::less_equal for smaller elements in left partition,
+    /// std::greater_equal for greater elements in left partition).
+    ///
+    /// @param begin,end const iterators to the initial and final positions of
+    /// the sequence to be pivoted. The range used is [first,last), which contains all the elements between
+    /// first and last, including the element pointed by first but not the element pointed by last.
+    /// @param pivot iterator on which the partition is delimited between begin and end.
+    ///
+    /// @return pair of iterators delimiting the sequence [first, second[ of elements equivalent to the pivot,
+    /// <pivot,pivot> if the partition could not be processed.
+    template <typename IT, typename Compare = std::less_equal<typename std::iterator_traits<IT>::value_type>>
+    std::pair<IT, IT> ThreeWayPartition(const IT& begin, const IT& pivot, const IT& end)
+    {
+      if (std::distance(begin, end) < 1 || pivot == end)
+        return std::make_pair(pivot, pivot);
+
+      const auto pivotValue = *pivot; // Keep the pivot value;
+      auto lowIt = begin;             // First element equivalent to the pivot
+      auto highIt = end;              // First element strictly after the pivot
+
+      // Strict ordering is deduced from the non-strict Compare: a < b <=> !(b <= a)
+      for (auto it = begin; it < highIt;)
+      {
+        if (!Compare()(pivotValue, *it))
+          std::swap(*(lowIt++), *(it++));
+        else if (!Compare()(*it, pivotValue))
+          std::swap(*it, *(--highIt));
+        else
+          ++it;
+      }
+
+      return std::make_pair(lowIt, highIt);
+    }
   }
 }
 